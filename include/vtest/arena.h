@@ -0,0 +1,195 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace vtest {
+	/// A bump pointer arena.  Allocation is a pointer increment, deallocation
+	/// only gives back the most recent block, and release( ) rewinds to the
+	/// start of the initial buffer and frees any overflow chunks.
+	class bump_arena {
+		std::byte *m_initial_first;
+		std::byte *m_initial_last;
+		std::byte *m_first;
+		std::byte *m_last;
+		std::byte *m_pos;
+		std::vector<std::unique_ptr<std::byte[]>> m_overflow{ };
+
+		static std::byte *align_up( std::byte *p, std::size_t align ) noexcept {
+			auto const addr = reinterpret_cast<std::uintptr_t>( p );
+			return p + ( ( align - ( addr % align ) ) % align );
+		}
+
+		void grow( std::size_t min_bytes ) {
+			auto const size = ( std::max )(
+			  min_bytes, 2U * static_cast<std::size_t>( m_last - m_first ) );
+			m_first = m_overflow
+			            .emplace_back(
+			              std::make_unique_for_overwrite<std::byte[]>( size ) )
+			            .get( );
+			m_last = m_first + size;
+			m_pos = m_first;
+		}
+
+	public:
+		bump_arena( void *buffer, std::size_t size ) noexcept
+		  : m_initial_first( static_cast<std::byte *>( buffer ) )
+		  , m_initial_last( m_initial_first + size )
+		  , m_first( m_initial_first )
+		  , m_last( m_initial_last )
+		  , m_pos( m_initial_first ) {}
+
+		bump_arena( bump_arena const & ) = delete;
+		bump_arena &operator=( bump_arena const & ) = delete;
+
+		[[nodiscard]] void *allocate( std::size_t bytes, std::size_t align ) {
+			auto *p = align_up( m_pos, align );
+			if( bytes > static_cast<std::size_t>( m_last - p ) ) [[unlikely]] {
+				grow( bytes + align );
+				p = align_up( m_pos, align );
+			}
+			m_pos = p + bytes;
+			return p;
+		}
+
+		void deallocate( void *ptr, std::size_t bytes ) noexcept {
+			auto *p = static_cast<std::byte *>( ptr );
+			if( p + bytes == m_pos ) {
+				m_pos = p;
+			}
+		}
+
+		void release( ) noexcept {
+			m_overflow.clear( );
+			m_first = m_initial_first;
+			m_last = m_initial_last;
+			m_pos = m_initial_first;
+		}
+	};
+
+	/// The resource that default constructed allocators on this thread draw
+	/// from; set by arena_scope
+	template<typename Resource>
+	Resource *&current_resource( ) noexcept {
+		thread_local Resource *result = nullptr;
+		return result;
+	}
+
+	/// A polymorphic_allocator that default constructs to the current Resource,
+	/// so that containers built with Vec v; use the benchmark's resource
+	template<typename T, typename Resource>
+	struct pmr_alloc : std::pmr::polymorphic_allocator<T> {
+		using resource_type = Resource;
+
+		template<typename U>
+		struct rebind {
+			using other = pmr_alloc<U, Resource>;
+		};
+
+		pmr_alloc( ) noexcept
+		  : std::pmr::polymorphic_allocator<T>(
+		      current_resource<Resource>( )
+		        ? current_resource<Resource>( )
+		        : std::pmr::get_default_resource( ) ) {}
+
+		template<typename U>
+		pmr_alloc( pmr_alloc<U, Resource> const &other ) noexcept
+		  : std::pmr::polymorphic_allocator<T>( other.resource( ) ) {}
+	};
+
+	/// An allocator over the current bump_arena
+	template<typename T>
+	struct arena_alloc {
+		using value_type = T;
+		using resource_type = bump_arena;
+
+		bump_arena *arena = current_resource<bump_arena>( );
+
+		arena_alloc( ) = default;
+
+		template<typename U>
+		constexpr arena_alloc( arena_alloc<U> const &other ) noexcept
+		  : arena( other.arena ) {}
+
+		[[nodiscard]] T *allocate( std::size_t count ) {
+			return static_cast<T *>(
+			  arena->allocate( count * sizeof( T ), alignof( T ) ) );
+		}
+
+		void deallocate( T *ptr, std::size_t count ) noexcept {
+			arena->deallocate( ptr, count * sizeof( T ) );
+		}
+
+		template<typename U>
+		constexpr bool operator==( arena_alloc<U> const &rhs ) const noexcept {
+			return arena == rhs.arena;
+		}
+	};
+
+	/// Owns the Resource behind Alloc for one benchmark and makes it current.
+	/// Resources that can start from a buffer get one of buffer_bytes.  For
+	/// allocators without a resource_type it does nothing.
+	template<typename Alloc>
+	class arena_scope {
+	public:
+		explicit arena_scope( std::size_t ) noexcept {}
+		void release( ) noexcept {}
+	};
+
+	template<typename Alloc>
+	requires requires { typename Alloc::resource_type; }
+	class arena_scope<Alloc> {
+		using resource_type = typename Alloc::resource_type;
+		static constexpr bool uses_buffer =
+		  std::is_constructible_v<resource_type, void *, std::size_t>;
+
+		std::unique_ptr<std::byte[]> m_buffer;
+		resource_type m_resource;
+		resource_type *m_previous;
+
+		static resource_type make_resource( std::byte *buffer,
+		                                    std::size_t size ) {
+			if constexpr( uses_buffer ) {
+				return resource_type( buffer, size );
+			} else {
+				return resource_type( );
+			}
+		}
+
+	public:
+		explicit arena_scope( std::size_t buffer_bytes )
+		  : m_buffer( uses_buffer ? std::make_unique_for_overwrite<std::byte[]>(
+		                              buffer_bytes )
+		                          : nullptr )
+		  , m_resource( make_resource( m_buffer.get( ), buffer_bytes ) )
+		  , m_previous( std::exchange( current_resource<resource_type>( ),
+		                               &m_resource ) ) {}
+
+		arena_scope( arena_scope const & ) = delete;
+		arena_scope &operator=( arena_scope const & ) = delete;
+
+		~arena_scope( ) {
+			current_resource<resource_type>( ) = m_previous;
+		}
+
+		/// Frees everything allocated from the resource at once
+		void release( ) noexcept {
+			m_resource.release( );
+		}
+	};
+} // namespace vtest
@@ -0,0 +1,285 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Reads the runs out of a Google Benchmark --benchmark_format=json report.
+/// Only what is needed for that is parsed; the context and any other nested
+/// values are checked for balance and skipped.
+namespace vtest {
+	struct bench_run {
+		/// The registration, e.g. bench_vec_pb<daw_vec<int>>/1024, shared by
+		/// all repetitions of it
+		std::string run_name;
+		double real_time_ns = 0.0;
+		double cpu_time_ns = 0.0;
+	};
+
+	namespace bench_json_impl {
+		class parser {
+			std::string_view m_text;
+			std::size_t m_pos = 0;
+
+			[[noreturn]] void fail( char const *what ) const {
+				throw std::runtime_error( std::string( what ) + " at offset " +
+				                          std::to_string( m_pos ) );
+			}
+
+			[[nodiscard]] char peek( ) const {
+				if( m_pos >= m_text.size( ) ) {
+					fail( "unexpected end of JSON" );
+				}
+				return m_text[m_pos];
+			}
+
+		public:
+			explicit parser( std::string_view text ) noexcept
+			  : m_text( text ) {}
+
+			void skip_ws( ) {
+				while( m_pos < m_text.size( ) and
+				       ( m_text[m_pos] == ' ' or m_text[m_pos] == '\t' or
+				         m_text[m_pos] == '\n' or m_text[m_pos] == '\r' ) ) {
+					++m_pos;
+				}
+			}
+
+			/// Consumes c, after any whitespace, if it is next
+			bool consume( char c ) {
+				skip_ws( );
+				if( m_pos < m_text.size( ) and m_text[m_pos] == c ) {
+					++m_pos;
+					return true;
+				}
+				return false;
+			}
+
+			void expect( char c ) {
+				if( not consume( c ) ) {
+					fail( ( std::string( "expected '" ) + c + '\'' ).c_str( ) );
+				}
+			}
+
+			std::string string( ) {
+				expect( '"' );
+				auto result = std::string( );
+				while( true ) {
+					char c = peek( );
+					++m_pos;
+					if( c == '"' ) {
+						return result;
+					}
+					if( c != '\\' ) {
+						result += c;
+						continue;
+					}
+					c = peek( );
+					++m_pos;
+					switch( c ) {
+					case 'b':
+						result += '\b';
+						break;
+					case 'f':
+						result += '\f';
+						break;
+					case 'n':
+						result += '\n';
+						break;
+					case 'r':
+						result += '\r';
+						break;
+					case 't':
+						result += '\t';
+						break;
+					case 'u': {
+						// Benchmark names are ASCII; keep other code points as ?
+						if( m_pos + 4 > m_text.size( ) ) {
+							fail( "truncated escape" );
+						}
+						auto const code =
+						  std::stoul( std::string( m_text.substr( m_pos, 4 ) ), nullptr, 16 );
+						result += code < 0x80 ? static_cast<char>( code ) : '?';
+						m_pos += 4;
+						break;
+					}
+					default:
+						result += c;
+					}
+				}
+			}
+
+			/// A JSON number or literal, as its text.  Besides true, false and
+			/// null the library writes NaN, Infinity and -Infinity for doubles
+			/// that are not finite.
+			std::string scalar( ) {
+				skip_ws( );
+				for( std::string_view literal :
+				     { "true", "false", "null", "NaN", "Infinity", "-Infinity" } ) {
+					if( m_text.substr( m_pos ).starts_with( literal ) ) {
+						m_pos += literal.size( );
+						return std::string( literal );
+					}
+				}
+				auto const first = m_pos;
+				while( m_pos < m_text.size( ) and
+				       std::string_view( "+-.0123456789Ee" ).find( m_text[m_pos] ) !=
+				         std::string_view::npos ) {
+					++m_pos;
+				}
+				if( first == m_pos ) {
+					fail( "expected a value" );
+				}
+				return std::string( m_text.substr( first, m_pos - first ) );
+			}
+
+			void skip_value( ) {
+				skip_ws( );
+				switch( peek( ) ) {
+				case '"':
+					(void)string( );
+					return;
+				case '{':
+					++m_pos;
+					if( consume( '}' ) ) {
+						return;
+					}
+					do {
+						(void)string( );
+						expect( ':' );
+						skip_value( );
+					} while( consume( ',' ) );
+					expect( '}' );
+					return;
+				case '[':
+					++m_pos;
+					if( consume( ']' ) ) {
+						return;
+					}
+					do {
+						skip_value( );
+					} while( consume( ',' ) );
+					expect( ']' );
+					return;
+				default:
+					(void)scalar( );
+				}
+			}
+
+			/// An object's string and scalar members; nested values are skipped
+			std::map<std::string, std::string> flat_object( ) {
+				auto result = std::map<std::string, std::string>( );
+				expect( '{' );
+				if( consume( '}' ) ) {
+					return result;
+				}
+				do {
+					auto key = string( );
+					expect( ':' );
+					skip_ws( );
+					switch( peek( ) ) {
+					case '"':
+						result[std::move( key )] = string( );
+						break;
+					case '{':
+					case '[':
+						skip_value( );
+						break;
+					default:
+						result[std::move( key )] = scalar( );
+					}
+				} while( consume( ',' ) );
+				expect( '}' );
+				return result;
+			}
+		};
+
+		inline double to_ns( double value, std::string const &unit ) {
+			if( unit == "us" ) {
+				return value * 1e3;
+			}
+			if( unit == "ms" ) {
+				return value * 1e6;
+			}
+			if( unit == "s" ) {
+				return value * 1e9;
+			}
+			return value;
+		}
+	} // namespace bench_json_impl
+
+	/// The iteration runs of the report text, one per repetition, in report
+	/// order.  Aggregates such as mean and the complexity fits are left out, as
+	/// are runs that reported an error.  Errors are prefixed with source.
+	inline std::vector<bench_run> parse_bench_json( std::string_view text,
+	                                                std::string const &source ) {
+		auto result = std::vector<bench_run>( );
+		try {
+			auto p = bench_json_impl::parser( text );
+			p.expect( '{' );
+			if( p.consume( '}' ) ) {
+				return result;
+			}
+			do {
+				auto const key = p.string( );
+				p.expect( ':' );
+				if( key != "benchmarks" ) {
+					p.skip_value( );
+					continue;
+				}
+				p.expect( '[' );
+				if( p.consume( ']' ) ) {
+					continue;
+				}
+				do {
+					auto run = p.flat_object( );
+					if( run["run_type"] == "aggregate" or
+					    run["error_occurred"] == "true" or
+					    not run.contains( "real_time" ) ) {
+						continue;
+					}
+					auto &name = run.contains( "run_name" ) ? run["run_name"]
+					                                        : run["name"];
+					auto const &unit = run["time_unit"];
+					result.push_back( bench_run{
+					  .run_name = std::move( name ),
+					  .real_time_ns =
+					    bench_json_impl::to_ns( std::stod( run["real_time"] ), unit ),
+					  .cpu_time_ns =
+					    bench_json_impl::to_ns( std::stod( run["cpu_time"] ), unit ) } );
+				} while( p.consume( ',' ) );
+				p.expect( ']' );
+			} while( p.consume( ',' ) );
+			p.expect( '}' );
+		} catch( std::exception const &ex ) {
+			throw std::runtime_error( source + ": " + ex.what( ) );
+		}
+		return result;
+	}
+
+	/// parse_bench_json of the file at path
+	inline std::vector<bench_run> read_bench_json( std::string const &path ) {
+		auto in = std::ifstream( path, std::ios::binary );
+		if( not in ) {
+			throw std::runtime_error( "Could not open " + path );
+		}
+		auto const text = std::string( std::istreambuf_iterator<char>( in ),
+		                               std::istreambuf_iterator<char>( ) );
+		return parse_bench_json( text, path );
+	}
+} // namespace vtest
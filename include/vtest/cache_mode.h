@@ -0,0 +1,96 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+// __GLIBC__ comes from the C library headers, so include one before testing it
+#include <cstdlib>
+#if defined( __GLIBC__ )
+#include <malloc.h>
+#endif
+
+#include "throughput.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace vtest {
+	enum class cache_mode {
+		/// Back to back iterations, reusing warm caches and malloc chunks
+		warm,
+		/// The caches are flushed before every iteration
+		cold_cache,
+		/// Free heap pages are returned to the OS before every iteration, so
+		/// the vector is built in never touched pages
+		first_touch
+	};
+
+	constexpr std::string_view cache_mode_name( cache_mode m ) noexcept {
+		switch( m ) {
+		case cache_mode::warm:
+			return "warm";
+		case cache_mode::cold_cache:
+			return "cold_cache";
+		case cache_mode::first_touch:
+			return "first_touch";
+		}
+		return "";
+	}
+
+	/// Bytes written to flush the caches: VTEST_EVICT_BYTES if set, otherwise
+	/// twice the largest cache Google Benchmark reports, at least 8MiB
+	inline std::size_t evict_bytes( ) {
+		static std::size_t const result = [] {
+			if( char const *env = std::getenv( "VTEST_EVICT_BYTES" ); env ) {
+				return static_cast<std::size_t>( std::strtoull( env, nullptr, 10 ) );
+			}
+			auto largest = std::size_t{ 0 };
+			for( auto const &c : benchmark::CPUInfo::Get( ).caches ) {
+				largest = ( std::max )( largest, static_cast<std::size_t>( c.size ) );
+			}
+			return ( std::max )( 2 * largest, std::size_t{ 8 } << 20U );
+		}( );
+		return result;
+	}
+
+	/// Writes a line of a buffer larger than the caches at a time
+	inline void evict_caches( ) {
+		constexpr std::size_t line_size = 64;
+		static auto const size = evict_bytes( );
+		static auto const buffer = std::make_unique<unsigned char[]>( size );
+		for( std::size_t i = 0; i < size; i += line_size ) {
+			++buffer[i];
+		}
+		benchmark::DoNotOptimize( buffer.get( ) );
+		benchmark::ClobberMemory( );
+	}
+
+	/// Returns free heap memory to the OS, where the C library supports it
+	inline void release_free_pages( ) {
+#if defined( __GLIBC__ )
+		malloc_trim( 0 );
+#endif
+	}
+
+	/// Called at the top of each benchmark iteration to set up Mode with the
+	/// timer paused
+	template<cache_mode Mode>
+	void prepare_iteration( benchmark::State &s ) {
+		if constexpr( Mode == cache_mode::cold_cache ) {
+			auto const paused = pause_timing( s );
+			evict_caches( );
+		} else if constexpr( Mode == cache_mode::first_touch ) {
+			auto const paused = pause_timing( s );
+			release_free_pages( );
+		}
+	}
+} // namespace vtest
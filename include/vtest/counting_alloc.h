@@ -0,0 +1,135 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+
+namespace vtest {
+	/// Running totals for every counting_alloc used on the current thread
+	struct alloc_stats {
+		std::size_t allocations = 0;
+		std::size_t bytes_allocated = 0;
+		/// Bytes in blocks released while a newer block was live, i.e. what a
+		/// growing container had to relocate.  Counts the whole old block, so it
+		/// is exact for growth from full and an upper bound otherwise.
+		std::size_t bytes_relocated = 0;
+		std::size_t live_bytes = 0;
+		std::size_t peak_live_bytes = 0;
+		std::size_t last_alloc_bytes = 0;
+	};
+
+	inline alloc_stats &thread_alloc_stats( ) noexcept {
+		thread_local auto result = alloc_stats{ };
+		return result;
+	}
+
+	/// Forwards to Base and records every allocation in thread_alloc_stats( )
+	template<typename T, typename Base = std::allocator<T>>
+	struct counting_alloc : Base {
+		using value_type = T;
+		using base_traits = std::allocator_traits<Base>;
+
+		template<typename U>
+		struct rebind {
+			using other =
+			  counting_alloc<U, typename base_traits::template rebind_alloc<U>>;
+		};
+
+		counting_alloc( ) = default;
+
+		template<typename U, typename B>
+		constexpr counting_alloc( counting_alloc<U, B> const &other ) noexcept
+		  : Base( static_cast<B const &>( other ) ) {}
+
+		[[nodiscard]] T *allocate( std::size_t count ) {
+			T *result = base_traits::allocate( base( ), count );
+			auto const bytes = count * sizeof( T );
+			auto &stats = thread_alloc_stats( );
+			++stats.allocations;
+			stats.bytes_allocated += bytes;
+			stats.live_bytes += bytes;
+			stats.peak_live_bytes =
+			  ( std::max )( stats.peak_live_bytes, stats.live_bytes );
+			stats.last_alloc_bytes = bytes;
+			return result;
+		}
+
+		void deallocate( T *ptr, std::size_t count ) noexcept {
+			auto const bytes = count * sizeof( T );
+			auto &stats = thread_alloc_stats( );
+			stats.live_bytes -= bytes;
+			if( stats.live_bytes != 0 ) {
+				stats.bytes_relocated += bytes;
+			}
+			base_traits::deallocate( base( ), ptr, count );
+		}
+
+		template<typename U, typename B>
+		constexpr bool
+		operator==( counting_alloc<U, B> const &rhs ) const noexcept {
+			return static_cast<Base const &>( *this ) ==
+			       static_cast<B const &>( rhs );
+		}
+
+	private:
+		Base &base( ) noexcept {
+			return *this;
+		}
+	};
+
+	/// Reports the counting_alloc activity over its lifetime: allocations,
+	/// bytes allocated and bytes relocated per iteration, peak live bytes and
+	/// the last block size relative to the n elements requested.  Nothing is
+	/// reported when the container under test does not use counting_alloc.
+	template<typename T>
+	class alloc_counter {
+		benchmark::State &m_state;
+		std::size_t m_elements;
+		alloc_stats m_start;
+
+	public:
+		alloc_counter( benchmark::State &s, std::size_t elements ) noexcept
+		  : m_state( s )
+		  , m_elements( elements )
+		  , m_start( thread_alloc_stats( ) ) {
+			auto &stats = thread_alloc_stats( );
+			stats.peak_live_bytes = stats.live_bytes;
+		}
+
+		alloc_counter( alloc_counter const & ) = delete;
+		alloc_counter &operator=( alloc_counter const & ) = delete;
+
+		~alloc_counter( ) {
+			auto const &stats = thread_alloc_stats( );
+			auto const allocations = stats.allocations - m_start.allocations;
+			if( allocations == 0 ) {
+				return;
+			}
+			auto const avg = []( std::size_t v ) {
+				return benchmark::Counter( static_cast<double>( v ),
+				                           benchmark::Counter::kAvgIterations );
+			};
+			m_state.counters["allocs"] = avg( allocations );
+			m_state.counters["bytes_alloc"] =
+			  avg( stats.bytes_allocated - m_start.bytes_allocated );
+			m_state.counters["bytes_relocated"] =
+			  avg( stats.bytes_relocated - m_start.bytes_relocated );
+			m_state.counters["peak_bytes"] =
+			  static_cast<double>( stats.peak_live_bytes );
+			if( m_elements != 0 ) {
+				m_state.counters["capacity_ratio"] =
+				  static_cast<double>( stats.last_alloc_bytes ) /
+				  static_cast<double>( m_elements * sizeof( T ) );
+			}
+		}
+	};
+} // namespace vtest
@@ -0,0 +1,104 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace vtest {
+	/// Forwards to Base, but default-initialises rather than value-initialises
+	/// when constructing without arguments, so resize( n ) on a container using
+	/// it leaves trivial elements uninitialised
+	template<typename T, typename Base = std::allocator<T>>
+	struct default_init_alloc : Base {
+		using value_type = T;
+		using base_traits = std::allocator_traits<Base>;
+
+		template<typename U>
+		struct rebind {
+			using other =
+			  default_init_alloc<U, typename base_traits::template rebind_alloc<U>>;
+		};
+
+		default_init_alloc( ) = default;
+
+		template<typename U, typename B>
+		constexpr default_init_alloc( default_init_alloc<U, B> const &other ) noexcept
+		  : Base( static_cast<B const &>( other ) ) {}
+
+		template<typename U>
+		void construct( U *ptr ) noexcept(
+		  std::is_nothrow_default_constructible_v<U> ) {
+			::new( static_cast<void *>( ptr ) ) U;
+		}
+
+		template<typename U, typename... Args>
+		void construct( U *ptr, Args &&...args ) {
+			base_traits::construct( static_cast<Base &>( *this ),
+			                        ptr,
+			                        std::forward<Args>( args )... );
+		}
+
+		template<typename U, typename B>
+		constexpr bool
+		operator==( default_init_alloc<U, B> const &rhs ) const noexcept {
+			return static_cast<Base const &>( *this ) ==
+			       static_cast<B const &>( rhs );
+		}
+	};
+
+	template<typename Alloc>
+	inline constexpr bool is_default_init_alloc_v = false;
+
+	template<typename T, typename Base>
+	inline constexpr bool
+	  is_default_init_alloc_v<default_init_alloc<T, Base>> = true;
+
+	/// Whether Vec has a resize_and_overwrite member taking op( data, count )
+	template<typename Vec>
+	inline constexpr bool has_resize_and_overwrite_v =
+	  requires( Vec &v, std::size_t n ) {
+		  v.resize_and_overwrite(
+		    n, []( typename Vec::value_type *, std::size_t m ) { return m; } );
+	  };
+
+	/// Whether resize_default_init( v, n ) leaves the new elements of Vec
+	/// uninitialised rather than zeroing them first
+	template<typename Vec>
+	inline constexpr bool resize_default_init_skips_v =
+	  requires( Vec &v, std::size_t n ) { v.resize_default_init( n ); } or
+	  is_default_init_alloc_v<typename Vec::allocator_type> or
+	  has_resize_and_overwrite_v<Vec>;
+
+	/// Grows v to n elements without initialising the new ones, for callers
+	/// that fill data( ) afterwards, such as C decoders.  Uses, in order, a
+	/// resize_default_init member, resize on a default_init_alloc, or a
+	/// resize_and_overwrite that leaves the storage as it is.  Anything else
+	/// falls back to resize( n ), which value-initialises.  v should start
+	/// empty, as some resize_and_overwrite members discard what v holds.
+	template<typename Vec>
+	void resize_default_init( Vec &v, std::size_t n ) {
+		using T = typename Vec::value_type;
+		static_assert( std::is_trivially_default_constructible_v<T>,
+		               "uninitialised elements must be trivially constructible" );
+		if constexpr( requires { v.resize_default_init( n ); } ) {
+			v.resize_default_init( n );
+		} else if constexpr( is_default_init_alloc_v<
+		                       typename Vec::allocator_type> ) {
+			v.resize( n );
+		} else if constexpr( has_resize_and_overwrite_v<Vec> ) {
+			v.resize_and_overwrite( n, []( T *, std::size_t m ) { return m; } );
+		} else {
+			v.resize( n );
+		}
+	}
+} // namespace vtest
@@ -0,0 +1,98 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+/// Element types that make a vector take its non-trivial construction,
+/// relocation and destruction paths.  Each is constructible from the
+/// std::size_t index the kernels use, so T( i ) works as it does for scalars.
+namespace vtest {
+	/// A std::string that fits in the small string buffer
+	struct sso_string : std::string {
+		sso_string( ) = default;
+		explicit sso_string( std::size_t i )
+		  : std::string( 8, static_cast<char>( 'a' + i % 26 ) ) {}
+	};
+
+	/// A std::string long enough to always allocate
+	struct heap_string : std::string {
+		heap_string( ) = default;
+		explicit heap_string( std::size_t i )
+		  : std::string( 48, static_cast<char>( 'a' + i % 26 ) ) {}
+	};
+
+	/// A handle with user-defined moves and destructor, so it must be relocated
+	/// element by element
+	class move_only {
+		std::size_t m_handle = 0;
+
+	public:
+		move_only( ) = default;
+		explicit move_only( std::size_t i ) noexcept
+		  : m_handle( i + 1 ) {}
+
+		move_only( move_only const & ) = delete;
+		move_only &operator=( move_only const & ) = delete;
+
+		move_only( move_only &&other ) noexcept
+		  : m_handle( other.m_handle ) {
+			other.m_handle = 0;
+		}
+
+		move_only &operator=( move_only &&rhs ) noexcept {
+			m_handle = rhs.m_handle;
+			rhs.m_handle = 0;
+			return *this;
+		}
+
+		~move_only( ) {}
+
+		[[nodiscard]] std::size_t handle( ) const noexcept {
+			return m_handle;
+		}
+	};
+
+	/// An aggregate whose owning member makes it non-trivially destructible.
+	/// owned stays null so that construction does not measure the allocator.
+	struct owning_aggregate {
+		std::size_t id;
+		double weight = 1.0;
+		std::unique_ptr<std::size_t> owned = nullptr;
+	};
+
+	/// The trivially copyable counterpart of owning_aggregate, for emplacing
+	/// with more than one argument
+	struct weighted_id {
+		std::size_t id;
+		double weight = 1.0;
+	};
+
+	/// 64 bytes of trivially copyable data
+	struct pod64 {
+		std::size_t values[8];
+
+		pod64( ) = default;
+		explicit pod64( std::size_t i ) noexcept
+		  : values{ i } {}
+	};
+
+	static_assert( not std::is_trivially_copyable_v<move_only> );
+	static_assert( std::is_nothrow_move_constructible_v<move_only> );
+	static_assert( std::is_aggregate_v<owning_aggregate> );
+	static_assert( not std::is_trivially_destructible_v<owning_aggregate> );
+	static_assert( std::is_aggregate_v<weighted_id> );
+	static_assert( std::is_trivially_copyable_v<weighted_id> );
+	static_assert( sizeof( pod64 ) == 64 );
+	static_assert( std::is_trivially_copyable_v<pod64> );
+	static_assert( std::is_trivially_default_constructible_v<pod64> );
+} // namespace vtest
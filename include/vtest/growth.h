@@ -0,0 +1,139 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include "counting_alloc.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+namespace vtest {
+	/// Multiply the capacity by Num / Den, starting from Initial elements
+	template<std::size_t Num, std::size_t Den, std::size_t Initial = 1>
+	struct geometric_growth {
+		static_assert( Num > Den );
+		static constexpr std::size_t initial = Initial;
+
+		static constexpr std::size_t next( std::size_t capacity ) noexcept {
+			return ( std::max )( capacity + 1, capacity * Num / Den );
+		}
+	};
+
+	/// Double the capacity until a step would add more than MaxStep elements,
+	/// then grow by MaxStep
+	template<std::size_t MaxStep, std::size_t Initial = 1>
+	struct capped_growth {
+		static constexpr std::size_t initial = Initial;
+
+		static constexpr std::size_t next( std::size_t capacity ) noexcept {
+			return capacity + std::clamp<std::size_t>( capacity, 1, MaxStep );
+		}
+	};
+
+	/// Where a reallocation left the block and how many bytes it had to copy
+	/// to get there
+	struct realloc_result {
+		void *ptr;
+		std::size_t bytes_copied;
+	};
+
+	/// Reallocation through malloc/realloc/free
+	struct c_realloc {
+		[[nodiscard]] static realloc_result reallocate( void *ptr,
+		                                               std::size_t,
+		                                               std::size_t new_bytes,
+		                                               std::size_t used_bytes ) {
+			auto *result = std::realloc( ptr, new_bytes );
+			if( not result ) {
+				throw std::bad_alloc( );
+			}
+			return { result, ptr and result != ptr ? used_bytes : 0 };
+		}
+
+		static void release( void *ptr, std::size_t ) noexcept {
+			std::free( ptr );
+		}
+	};
+
+	/// Just enough of a vector to push_back into, growing by the Growth policy
+	/// through Realloc, c_realloc by default.  It records its allocations in
+	/// thread_alloc_stats( ) the same way counting_alloc does, so alloc_counter
+	/// reports it alongside the counted std::vector and daw::vector.
+	template<typename T, typename Growth, typename Realloc = c_realloc>
+	class realloc_vector {
+		static_assert( std::is_trivially_copyable_v<T>,
+		               "realloc can only relocate trivially copyable types" );
+
+		T *m_data = nullptr;
+		std::size_t m_size = 0;
+		std::size_t m_capacity = 0;
+
+		void grow( ) {
+			auto const new_capacity =
+			  m_capacity == 0 ? Growth::initial : Growth::next( m_capacity );
+			auto const old_bytes = m_capacity * sizeof( T );
+			auto const new_bytes = new_capacity * sizeof( T );
+			auto const result = Realloc::reallocate(
+			  m_data, old_bytes, new_bytes, m_size * sizeof( T ) );
+			auto &stats = thread_alloc_stats( );
+			++stats.allocations;
+			stats.bytes_allocated += new_bytes;
+			stats.last_alloc_bytes = new_bytes;
+			auto const others = stats.live_bytes - old_bytes;
+			if( result.bytes_copied != 0 ) {
+				// Both blocks were live during the copy
+				stats.bytes_relocated += result.bytes_copied;
+				stats.peak_live_bytes = ( std::max )( stats.peak_live_bytes,
+				                                      others + old_bytes + new_bytes );
+			}
+			stats.live_bytes = others + new_bytes;
+			stats.peak_live_bytes =
+			  ( std::max )( stats.peak_live_bytes, stats.live_bytes );
+			m_data = static_cast<T *>( result.ptr );
+			m_capacity = new_capacity;
+		}
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+
+		realloc_vector( ) = default;
+		realloc_vector( realloc_vector const & ) = delete;
+		realloc_vector &operator=( realloc_vector const & ) = delete;
+
+		~realloc_vector( ) {
+			thread_alloc_stats( ).live_bytes -= m_capacity * sizeof( T );
+			if( m_data ) {
+				Realloc::release( m_data, m_capacity * sizeof( T ) );
+			}
+		}
+
+		void push_back( T const &value ) {
+			if( m_size == m_capacity ) [[unlikely]] {
+				grow( );
+			}
+			m_data[m_size++] = value;
+		}
+
+		[[nodiscard]] T *data( ) noexcept {
+			return m_data;
+		}
+
+		[[nodiscard]] std::size_t size( ) const noexcept {
+			return m_size;
+		}
+
+		[[nodiscard]] std::size_t capacity( ) const noexcept {
+			return m_capacity;
+		}
+	};
+} // namespace vtest
@@ -0,0 +1,49 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include <iterator>
+
+namespace vtest {
+	/// Wraps an iterator as a single pass input iterator, so that range
+	/// construction from it cannot size the allocation up front
+	template<typename Iterator>
+	class input_iterator {
+		Iterator m_it{ };
+
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = std::iter_value_t<Iterator>;
+		using difference_type = std::iter_difference_t<Iterator>;
+		using reference = std::iter_reference_t<Iterator>;
+		using pointer = void;
+
+		input_iterator( ) = default;
+		explicit input_iterator( Iterator it )
+		  : m_it( it ) {}
+
+		reference operator*( ) const {
+			return *m_it;
+		}
+
+		input_iterator &operator++( ) {
+			++m_it;
+			return *this;
+		}
+
+		input_iterator operator++( int ) {
+			auto result = *this;
+			++m_it;
+			return result;
+		}
+
+		friend bool operator==( input_iterator const &,
+		                        input_iterator const & ) = default;
+	};
+} // namespace vtest
@@ -0,0 +1,121 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace vtest {
+	struct mann_whitney_result {
+		/// U of the first sample: the pairs ( a, b ) with a > b, ties counting
+		/// a half
+		double u = 0.0;
+		/// Two-sided p-value of the samples coming from the same distribution
+		double p = 1.0;
+	};
+
+	namespace mann_whitney_impl {
+		/// Two-sided p-value of u from the exact distribution of U, for samples
+		/// without ties.  ways[n][k] counts the arrangements of m values from the
+		/// first sample and n from the second with U = k, built up one m at a
+		/// time.
+		inline double exact_p( std::size_t m, std::size_t n, double u ) {
+			auto const max_u = m * n;
+			auto ways = std::vector<std::vector<double>>(
+			  n + 1, std::vector<double>( max_u + 1, 0.0 ) );
+			for( auto &w : ways ) {
+				w[0] = 1.0;
+			}
+			for( std::size_t i = 1; i <= m; ++i ) {
+				auto next = std::vector<std::vector<double>>(
+				  n + 1, std::vector<double>( max_u + 1, 0.0 ) );
+				next[0][0] = 1.0;
+				for( std::size_t j = 1; j <= n; ++j ) {
+					for( std::size_t k = 0; k <= i * j; ++k ) {
+						// The largest value is from the first sample, above all j of the
+						// second, or from the second, adding nothing
+						next[j][k] = ( k >= j ? ways[j][k - j] : 0.0 ) + next[j - 1][k];
+					}
+				}
+				ways = std::move( next );
+			}
+			auto total = 0.0;
+			for( auto w : ways[n] ) {
+				total += w;
+			}
+			// U is symmetric about m * n / 2, so take the tail u is in, doubled
+			auto const lo = ( std::min )( u, static_cast<double>( max_u ) - u );
+			auto tail = 0.0;
+			for( std::size_t k = 0; static_cast<double>( k ) <= lo; ++k ) {
+				tail += ways[n][k];
+			}
+			return ( std::min )( 1.0, 2.0 * tail / total );
+		}
+	} // namespace mann_whitney_impl
+
+	/// The Mann-Whitney U test of a against b.  Small samples without ties use
+	/// the exact distribution of U, the rest the normal approximation with tie
+	/// and continuity corrections.  Either sample being empty gives p = 1.
+	inline mann_whitney_result mann_whitney_u( std::span<double const> a,
+	                                           std::span<double const> b ) {
+		auto const m = a.size( );
+		auto const n = b.size( );
+		if( m == 0 or n == 0 ) {
+			return { };
+		}
+		// Rank the pooled samples, giving ties their average rank
+		auto pooled = std::vector<std::pair<double, bool>>( );
+		pooled.reserve( m + n );
+		for( auto x : a ) {
+			pooled.emplace_back( x, true );
+		}
+		for( auto x : b ) {
+			pooled.emplace_back( x, false );
+		}
+		std::sort( pooled.begin( ), pooled.end( ) );
+		auto rank_sum = 0.0;
+		auto tie_term = 0.0;
+		for( std::size_t first = 0; first < pooled.size( ); ) {
+			auto last = first + 1;
+			while( last < pooled.size( ) and
+			       pooled[last].first == pooled[first].first ) {
+				++last;
+			}
+			auto const count = static_cast<double>( last - first );
+			auto const rank = static_cast<double>( first + last + 1 ) / 2.0;
+			for( auto i = first; i < last; ++i ) {
+				if( pooled[i].second ) {
+					rank_sum += rank;
+				}
+			}
+			tie_term += count * count * count - count;
+			first = last;
+		}
+		auto const md = static_cast<double>( m );
+		auto const nd = static_cast<double>( n );
+		auto const u = rank_sum - md * ( md + 1.0 ) / 2.0;
+		if( tie_term == 0.0 and m * n <= 400 ) {
+			return { u, mann_whitney_impl::exact_p( m, n, u ) };
+		}
+		auto const mean = md * nd / 2.0;
+		auto const variance =
+		  md * nd / 12.0 *
+		  ( ( md + nd + 1.0 ) - tie_term / ( ( md + nd ) * ( md + nd - 1.0 ) ) );
+		if( variance <= 0.0 ) {
+			return { u, 1.0 };
+		}
+		auto const z =
+		  ( std::max )( std::abs( u - mean ) - 0.5, 0.0 ) / std::sqrt( variance );
+		return { u, std::erfc( z / std::sqrt( 2.0 ) ) };
+	}
+} // namespace vtest
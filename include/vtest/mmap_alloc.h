@@ -0,0 +1,182 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include "growth.h"
+
+#include <sys/mman.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace vtest {
+	enum class mmap_hint {
+		/// Plain anonymous mapping, same as daw::MMapAlloc
+		none,
+		/// MAP_POPULATE, pages are faulted in by mmap itself
+		populate,
+		/// 2MiB aligned mapping with madvise( MADV_HUGEPAGE )
+		huge_pages
+	};
+
+	inline constexpr std::size_t huge_page_size = 2U * 1024U * 1024U;
+
+	/// An allocator that gives each allocation its own anonymous mapping, like
+	/// daw::MMapAlloc, but lets the benchmark choose how the pages are backed
+	template<typename T, mmap_hint Hint = mmap_hint::none>
+	struct mmap_alloc {
+		using value_type = T;
+
+		template<typename U>
+		struct rebind {
+			using other = mmap_alloc<U, Hint>;
+		};
+
+		mmap_alloc( ) = default;
+
+		template<typename U>
+		constexpr mmap_alloc( mmap_alloc<U, Hint> const & ) noexcept {}
+
+		[[nodiscard]] static constexpr std::size_t
+		mapping_size( std::size_t count ) noexcept {
+			auto const sz = count * sizeof( T );
+			if constexpr( Hint == mmap_hint::huge_pages ) {
+				return ( sz + huge_page_size - 1U ) & ~( huge_page_size - 1U );
+			} else {
+				return sz;
+			}
+		}
+
+		[[nodiscard]] T *allocate( std::size_t count ) {
+			auto const sz = mapping_size( count );
+			int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+			if constexpr( Hint == mmap_hint::populate ) {
+				flags |= MAP_POPULATE;
+			}
+			if constexpr( Hint == mmap_hint::huge_pages ) {
+				// Over map so that the range can be trimmed to a huge page boundary,
+				// otherwise the kernel can only back the aligned middle with THP
+				auto const over_sz = sz + huge_page_size;
+				void *p =
+				  mmap( nullptr, over_sz, PROT_READ | PROT_WRITE, flags, -1, 0 );
+				if( p == MAP_FAILED ) {
+					throw std::bad_alloc( );
+				}
+				auto const first = reinterpret_cast<std::uintptr_t>( p );
+				auto const aligned =
+				  ( first + huge_page_size - 1U ) & ~( huge_page_size - 1U );
+				if( aligned != first ) {
+					munmap( p, aligned - first );
+				}
+				auto const tail = ( first + over_sz ) - ( aligned + sz );
+				if( tail != 0 ) {
+					munmap( reinterpret_cast<void *>( aligned + sz ), tail );
+				}
+				auto *result = reinterpret_cast<void *>( aligned );
+				madvise( result, sz, MADV_HUGEPAGE );
+				return static_cast<T *>( result );
+			} else {
+				void *p = mmap( nullptr, sz, PROT_READ | PROT_WRITE, flags, -1, 0 );
+				if( p == MAP_FAILED ) {
+					throw std::bad_alloc( );
+				}
+				return static_cast<T *>( p );
+			}
+		}
+
+		void deallocate( T *ptr, std::size_t count ) noexcept {
+			munmap( ptr, mapping_size( count ) );
+		}
+
+		/// Extension: grow the mapping without moving it.  Returns false when the
+		/// address space after it is taken.
+		[[nodiscard]] bool try_expand( T *ptr,
+		                               std::size_t old_count,
+		                               std::size_t new_count ) noexcept {
+			return mremap( ptr,
+			               mapping_size( old_count ),
+			               mapping_size( new_count ),
+			               0 ) != MAP_FAILED;
+		}
+
+		/// Extension: grow the mapping, letting the kernel move it by remapping
+		/// the pages rather than copying them.  Only valid for trivially
+		/// relocatable T.  The huge page alignment is not kept if it moves.
+		[[nodiscard]] T *
+		reallocate( T *ptr, std::size_t old_count, std::size_t new_count ) {
+			void *p = mremap( ptr,
+			                  mapping_size( old_count ),
+			                  mapping_size( new_count ),
+			                  MREMAP_MAYMOVE );
+			if( p == MAP_FAILED ) {
+				throw std::bad_alloc( );
+			}
+			return static_cast<T *>( p );
+		}
+
+		template<typename U>
+		constexpr bool operator==( mmap_alloc<U, Hint> const & ) const noexcept {
+			return true;
+		}
+	};
+
+	/// A realloc_vector policy that grows mmap_alloc mappings by allocating a
+	/// new mapping, copying and unmapping the old one, as an allocator
+	/// without the mremap extension has to
+	template<mmap_hint Hint = mmap_hint::none>
+	struct mmap_copy_realloc {
+		using alloc_type = mmap_alloc<std::byte, Hint>;
+
+		[[nodiscard]] static realloc_result reallocate( void *ptr,
+		                                               std::size_t old_bytes,
+		                                               std::size_t new_bytes,
+		                                               std::size_t used_bytes ) {
+			auto alloc = alloc_type( );
+			auto *result = alloc.allocate( new_bytes );
+			if( not ptr ) {
+				return { result, 0 };
+			}
+			std::memcpy( result, ptr, used_bytes );
+			alloc.deallocate( static_cast<std::byte *>( ptr ), old_bytes );
+			return { result, used_bytes };
+		}
+
+		static void release( void *ptr, std::size_t bytes ) noexcept {
+			alloc_type( ).deallocate( static_cast<std::byte *>( ptr ), bytes );
+		}
+	};
+
+	/// A realloc_vector policy that uses the mmap_alloc extensions, expanding
+	/// in place when it can and otherwise remapping, so no bytes are copied
+	template<mmap_hint Hint = mmap_hint::none>
+	struct mremap_realloc {
+		using alloc_type = mmap_alloc<std::byte, Hint>;
+
+		[[nodiscard]] static realloc_result reallocate( void *ptr,
+		                                               std::size_t old_bytes,
+		                                               std::size_t new_bytes,
+		                                               std::size_t ) {
+			auto alloc = alloc_type( );
+			auto *p = static_cast<std::byte *>( ptr );
+			if( not p ) {
+				return { alloc.allocate( new_bytes ), 0 };
+			}
+			if( alloc.try_expand( p, old_bytes, new_bytes ) ) {
+				return { p, 0 };
+			}
+			return { alloc.reallocate( p, old_bytes, new_bytes ), 0 };
+		}
+
+		static void release( void *ptr, std::size_t bytes ) noexcept {
+			alloc_type( ).deallocate( static_cast<std::byte *>( ptr ), bytes );
+		}
+	};
+} // namespace vtest
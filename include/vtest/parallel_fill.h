@@ -0,0 +1,134 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vtest {
+	/// A fixed set of workers that run one job at a time.  The calling thread
+	/// is worker 0, so a pool of N workers starts N - 1 threads.
+	class fill_pool {
+		std::mutex m_mut;
+		std::condition_variable m_start;
+		std::condition_variable m_done;
+		void ( *m_job )( void const *, std::size_t ) = nullptr;
+		void const *m_job_state = nullptr;
+		std::size_t m_generation = 0;
+		std::size_t m_pending = 0;
+		bool m_stop = false;
+		std::size_t m_workers;
+		std::vector<std::thread> m_threads;
+
+		void work( std::size_t index ) {
+			auto seen = std::size_t{ 0 };
+			while( true ) {
+				auto lck = std::unique_lock( m_mut );
+				m_start.wait( lck,
+				              [&] { return m_stop or m_generation != seen; } );
+				if( m_stop ) {
+					return;
+				}
+				seen = m_generation;
+				auto *job = m_job;
+				auto const *state = m_job_state;
+				lck.unlock( );
+				job( state, index );
+				lck.lock( );
+				if( --m_pending == 0 ) {
+					m_done.notify_one( );
+				}
+			}
+		}
+
+	public:
+		explicit fill_pool( std::size_t workers )
+		  : m_workers( ( std::max )( workers, std::size_t{ 1 } ) ) {
+			m_threads.reserve( m_workers - 1 );
+			for( std::size_t i = 1; i < m_workers; ++i ) {
+				m_threads.emplace_back( [this, i] { work( i ); } );
+			}
+		}
+
+		fill_pool( fill_pool const & ) = delete;
+		fill_pool &operator=( fill_pool const & ) = delete;
+
+		~fill_pool( ) {
+			{
+				auto const lck = std::lock_guard( m_mut );
+				m_stop = true;
+			}
+			m_start.notify_all( );
+			for( auto &t : m_threads ) {
+				t.join( );
+			}
+		}
+
+		[[nodiscard]] std::size_t size( ) const noexcept {
+			return m_workers;
+		}
+
+		/// Calls job( index ) once on each worker, index in [0, size( ) ), and
+		/// returns when they have all finished
+		template<typename Job>
+		void run( Job const &job ) {
+			if( m_workers > 1 ) {
+				auto const lck = std::lock_guard( m_mut );
+				m_job = []( void const *state, std::size_t index ) {
+					( *static_cast<Job const *>( state ) )( index );
+				};
+				m_job_state = &job;
+				m_pending = m_workers - 1;
+				++m_generation;
+			}
+			m_start.notify_all( );
+			job( std::size_t{ 0 } );
+			auto lck = std::unique_lock( m_mut );
+			m_done.wait( lck, [&] { return m_pending == 0; } );
+		}
+	};
+
+	/// Splits [ptr, ptr + count) into one contiguous chunk per worker, split
+	/// at the first element starting on or after a page boundary, and calls
+	/// op( first, chunk_size, offset ) for each on its own worker.  Freshly
+	/// allocated pages are therefore first touched by the thread that fills
+	/// them; only a page holding an element that straddles a split is shared.
+	template<typename T, typename Op>
+	void parallel_fill( fill_pool &pool, T *ptr, std::size_t count, Op op ) {
+		constexpr std::uintptr_t page_size = 4096;
+		auto const workers = pool.size( );
+		auto const addr = reinterpret_cast<std::uintptr_t>( ptr );
+		// Split points are page boundaries counted from the first page boundary
+		// in the buffer, which malloc rarely places at ptr itself
+		auto const first_page = ( addr + page_size - 1 ) / page_size * page_size;
+		auto chunk_bytes = ( count * sizeof( T ) + workers - 1 ) / workers;
+		chunk_bytes = ( chunk_bytes + page_size - 1 ) / page_size * page_size;
+		auto const split = [&]( std::size_t index ) -> std::size_t {
+			if( index == 0 ) {
+				return 0;
+			}
+			auto const boundary = first_page + index * chunk_bytes;
+			auto const elements =
+			  ( boundary - addr + sizeof( T ) - 1 ) / sizeof( T );
+			return ( std::min )( static_cast<std::size_t>( elements ), count );
+		};
+		pool.run( [&]( std::size_t index ) {
+			auto const first = split( index );
+			auto const last = split( index + 1 );
+			if( first != last ) {
+				op( ptr + first, last - first, first );
+			}
+		} );
+	}
+} // namespace vtest
@@ -0,0 +1,176 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+
+#if defined( VTEST_PERF_COUNTERS ) and defined( __linux__ )
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#endif
+
+namespace vtest {
+#if defined( VTEST_PERF_COUNTERS ) and defined( __linux__ )
+	namespace perf_impl {
+		struct event_desc {
+			char const *name;
+			std::uint32_t type;
+			std::uint64_t config;
+		};
+
+		constexpr std::uint64_t cache_read_miss( std::uint64_t cache ) noexcept {
+			return cache | ( PERF_COUNT_HW_CACHE_OP_READ << 8U ) |
+			       ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16U );
+		}
+
+		inline constexpr auto events = std::array<event_desc, 6>{ {
+		  { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+		  { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+		  { "branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+		  { "l1d_misses",
+		    PERF_TYPE_HW_CACHE,
+		    cache_read_miss( PERF_COUNT_HW_CACHE_L1D ) },
+		  { "llc_misses",
+		    PERF_TYPE_HW_CACHE,
+		    cache_read_miss( PERF_COUNT_HW_CACHE_LL ) },
+		  { "dtlb_misses",
+		    PERF_TYPE_HW_CACHE,
+		    cache_read_miss( PERF_COUNT_HW_CACHE_DTLB ) },
+		} };
+
+		/// Opens a user space only counter for the calling thread.  Returns -1
+		/// when the event is unsupported or perf_event_open is not permitted,
+		/// as is common in containers.
+		inline int open_event( event_desc const &ev ) noexcept {
+			auto attr = perf_event_attr{ };
+			std::memset( &attr, 0, sizeof( attr ) );
+			attr.size = sizeof( attr );
+			attr.type = ev.type;
+			attr.config = ev.config;
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format =
+			  PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			return static_cast<int>(
+			  syscall( SYS_perf_event_open, &attr, 0, -1, -1, 0 ) );
+		}
+
+		/// The count, scaled up when the kernel had to multiplex the counter
+		inline double read_event( int fd ) noexcept {
+			std::uint64_t buff[3] = { };
+			if( read( fd, buff, sizeof( buff ) ) != sizeof( buff ) or
+			    buff[2] == 0 ) {
+				return -1.0;
+			}
+			return static_cast<double>( buff[0] ) *
+			       ( static_cast<double>( buff[1] ) /
+			         static_cast<double>( buff[2] ) );
+		}
+
+		/// The counters the calling thread has open, for pause_perf_counters
+		inline std::vector<int> &open_fds( ) noexcept {
+			thread_local auto result = std::vector<int>( );
+			return result;
+		}
+
+		inline void set_enabled( bool enabled ) noexcept {
+			for( int fd : open_fds( ) ) {
+				ioctl( fd,
+				       enabled ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE,
+				       0 );
+			}
+		}
+	} // namespace perf_impl
+
+	/// Stops the calling thread's perf_counters counting, as when the timer is
+	/// paused for setup
+	inline void pause_perf_counters( ) noexcept {
+		perf_impl::set_enabled( false );
+	}
+
+	inline void resume_perf_counters( ) noexcept {
+		perf_impl::set_enabled( true );
+	}
+
+	/// Counts hardware events over its lifetime and reports each one as a user
+	/// counter per element per iteration.  Events that cannot be opened are
+	/// left out, so without perf access only the timings are reported.
+	class perf_counters {
+		benchmark::State &m_state;
+		std::size_t m_elements;
+		std::array<int, perf_impl::events.size( )> m_fds{ };
+
+	public:
+		perf_counters( benchmark::State &s, std::size_t elements ) noexcept
+		  : m_state( s )
+		  , m_elements( elements ) {
+			for( std::size_t n = 0; n < m_fds.size( ); ++n ) {
+				m_fds[n] = perf_impl::open_event( perf_impl::events[n] );
+			}
+			for( int fd : m_fds ) {
+				if( fd >= 0 ) {
+					perf_impl::open_fds( ).push_back( fd );
+					ioctl( fd, PERF_EVENT_IOC_RESET, 0 );
+					ioctl( fd, PERF_EVENT_IOC_ENABLE, 0 );
+				}
+			}
+		}
+
+		perf_counters( perf_counters const & ) = delete;
+		perf_counters &operator=( perf_counters const & ) = delete;
+
+		~perf_counters( ) {
+			auto &fds = perf_impl::open_fds( );
+			for( int fd : m_fds ) {
+				if( fd >= 0 ) {
+					ioctl( fd, PERF_EVENT_IOC_DISABLE, 0 );
+					fds.erase( std::remove( fds.begin( ), fds.end( ), fd ), fds.end( ) );
+				}
+			}
+			auto const elements =
+			  static_cast<double>( m_elements == 0 ? 1 : m_elements );
+			for( std::size_t n = 0; n < m_fds.size( ); ++n ) {
+				if( m_fds[n] < 0 ) {
+					continue;
+				}
+				auto const count = perf_impl::read_event( m_fds[n] );
+				close( m_fds[n] );
+				if( count < 0.0 ) {
+					continue;
+				}
+				m_state.counters[perf_impl::events[n].name] = benchmark::Counter(
+				  count / elements, benchmark::Counter::kAvgIterations );
+			}
+		}
+	};
+#else
+	inline void pause_perf_counters( ) noexcept {}
+	inline void resume_perf_counters( ) noexcept {}
+
+	/// Hardware counters are disabled, configure with
+	/// VTEST_ENABLE_PERF_COUNTERS=ON to report them
+	class perf_counters {
+	public:
+		constexpr perf_counters( benchmark::State &, std::size_t ) noexcept {}
+		perf_counters( perf_counters const & ) = delete;
+		perf_counters &operator=( perf_counters const & ) = delete;
+		~perf_counters( ) {}
+	};
+#endif
+} // namespace vtest
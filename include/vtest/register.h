@@ -0,0 +1,158 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace vtest {
+	/// The spelling of T as the compiler prints it, e.g. "int" or
+	/// "vtest::pod64"
+	template<typename T>
+	constexpr std::string_view type_name( ) noexcept {
+		std::string_view name = __PRETTY_FUNCTION__;
+#if defined( __clang__ )
+		constexpr std::string_view prefix = "[T = ";
+#else
+		constexpr std::string_view prefix = "[with T = ";
+#endif
+		name.remove_prefix( name.find( prefix ) + prefix.size( ) );
+		return name.substr( 0, name.find_first_of( ";]" ) );
+	}
+
+	template<typename... Ts>
+	struct types {};
+
+	/// A container alias template and the name it is registered under
+	template<template<typename> class Container>
+	struct container {
+		std::string_view name;
+	};
+
+	/// A kernel function template.  kernel_of( std::type_identity<Arg>{ } )
+	/// returns the instantiation for Arg; see VTEST_KERNEL.
+	template<typename KernelOf>
+	struct kernel {
+		std::string_view name;
+		KernelOf kernel_of;
+	};
+
+#define VTEST_KERNEL( Name )                                                  \
+	vtest::kernel {                                                             \
+		#Name, []<typename Arg>( std::type_identity<Arg> ) { return &Name<Arg>; } \
+	}
+
+	/// Element counts to run, first, first * multiplier ... up to last, plus
+	/// any extra sizes off that progression.  When max_threads is above 1 each
+	/// size also runs on 1, 2, 4 ... max_threads threads, timed in real time,
+	/// and no complexity is fitted since the thread counts share a family.
+	/// max_workers does the same for kernels that take a worker count as
+	/// range( 1 ), for pools they run themselves.  A non-zero iterations fixes
+	/// the iteration count, for kernels whose untimed setup would otherwise run
+	/// until the timed part reaches the minimum time.
+	struct sizes {
+		std::int64_t first;
+		std::int64_t last;
+		std::vector<std::int64_t> extra{ };
+		int multiplier = 2;
+		int max_threads = 1;
+		int max_workers = 0;
+		std::int64_t iterations = 0;
+	};
+
+	namespace register_impl {
+		inline void apply_sizes( benchmark::internal::Benchmark *b,
+		                         sizes const &sz ) {
+			if( sz.iterations > 0 ) {
+				b->Iterations( sz.iterations );
+			}
+			if( sz.max_workers > 0 ) {
+				auto counts = std::vector<std::int64_t>( );
+				for( std::int64_t w = 1; w < sz.max_workers; w *= 2 ) {
+					counts.push_back( w );
+				}
+				counts.push_back( sz.max_workers );
+				auto ns = benchmark::CreateRange( sz.first, sz.last, sz.multiplier );
+				ns.insert( ns.end( ), sz.extra.begin( ), sz.extra.end( ) );
+				b->ArgsProduct( { ns, counts } )
+				  ->ArgNames( { "", "workers" } )
+				  ->UseRealTime( );
+				return;
+			}
+			b->RangeMultiplier( sz.multiplier )->Range( sz.first, sz.last );
+			for( auto n : sz.extra ) {
+				b->Arg( n );
+			}
+			if( sz.max_threads > 1 ) {
+				b->ThreadRange( 1, sz.max_threads )->UseRealTime( );
+			} else {
+				b->Complexity( benchmark::oAuto );
+			}
+		}
+
+		template<typename Arg, typename KernelOf>
+		void register_one( kernel<KernelOf> const &k,
+		                   std::string const &arg_name,
+		                   sizes const &sz ) {
+			auto const name = std::string( k.name ) + '<' + arg_name + '>';
+			apply_sizes(
+			  benchmark::RegisterBenchmark(
+			    name.c_str( ), k.kernel_of( std::type_identity<Arg>{ } ) ),
+			  sz );
+		}
+	} // namespace register_impl
+
+	/// Registers every kernel<Container<T>> over the sizes, ordered by kernel,
+	/// then T, then container.  Containers that are baselines for the others
+	/// have to be passed first.
+	template<typename... Kernels, typename... Ts, template<typename> class... Cs>
+	void register_sweep( std::tuple<Kernels...> const &kernels,
+	                     types<Ts...>,
+	                     sizes const &sz,
+	                     container<Cs> const &...cs ) {
+		std::apply(
+		  [&]( auto const &...k ) {
+			  auto const for_kernel = [&]( auto const &kern ) {
+				  auto const for_type = [&]<typename T>( std::type_identity<T> ) {
+					  auto const t_name = std::string( type_name<T>( ) );
+					  ( register_impl::register_one<Cs<T>>(
+					      kern, std::string( cs.name ) + '<' + t_name + '>', sz ),
+					    ... );
+				  };
+				  ( for_type( std::type_identity<Ts>{ } ), ... );
+			  };
+			  ( for_kernel( k ), ... );
+		  },
+		  kernels );
+	}
+
+	/// Registers every kernel<T> over the sizes, for kernels that are
+	/// parameterised on the element type rather than a container
+	template<typename... Kernels, typename... Ts>
+	void register_sweep( std::tuple<Kernels...> const &kernels,
+	                     types<Ts...>,
+	                     sizes const &sz ) {
+		std::apply(
+		  [&]( auto const &...k ) {
+			  auto const for_kernel = [&]( auto const &kern ) {
+				  ( register_impl::register_one<Ts>(
+				      kern, std::string( type_name<Ts>( ) ), sz ),
+				    ... );
+			  };
+			  ( for_kernel( k ), ... );
+		  },
+		  kernels );
+	}
+} // namespace vtest
@@ -0,0 +1,182 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include <sys/resource.h>
+#if defined( __GLIBC__ )
+#include <malloc.h>
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace vtest {
+	/// Minor page faults taken by the calling thread so far
+	inline long minor_faults( ) noexcept {
+		auto ru = rusage{ };
+		if( getrusage( RUSAGE_THREAD, &ru ) != 0 ) {
+			return 0;
+		}
+		return ru.ru_minflt;
+	}
+
+	/// Counts the minor page faults taken over its lifetime and reports them as
+	/// the minor_faults counter, averaged over the benchmark iterations
+	class minor_fault_counter {
+		benchmark::State &m_state;
+		long m_start;
+
+	public:
+		explicit minor_fault_counter( benchmark::State &s ) noexcept
+		  : m_state( s )
+		  , m_start( minor_faults( ) ) {}
+
+		minor_fault_counter( minor_fault_counter const & ) = delete;
+		minor_fault_counter &operator=( minor_fault_counter const & ) = delete;
+
+		~minor_fault_counter( ) {
+			m_state.counters["minor_faults"] = benchmark::Counter(
+			  static_cast<double>( minor_faults( ) - m_start ),
+			  benchmark::Counter::kAvgIterations );
+		}
+	};
+
+	/// Resets the process' peak resident set size so that VmHWM starts again
+	/// from the current RSS.  Returns false if /proc/self/clear_refs is not
+	/// writable.
+	inline bool reset_peak_rss( ) {
+		auto clear_refs = std::ofstream( "/proc/self/clear_refs" );
+		clear_refs << "5";
+		clear_refs.flush( );
+		return static_cast<bool>( clear_refs );
+	}
+
+	/// A size field of /proc/self/status, such as "VmHWM:", in bytes, or 0 if
+	/// it is unavailable
+	inline std::size_t status_bytes( std::string_view field ) {
+		auto status = std::ifstream( "/proc/self/status" );
+		auto line = std::string( );
+		while( std::getline( status, line ) ) {
+			if( line.starts_with( field ) ) {
+				return std::stoull( line.substr( field.size( ) ) ) * 1024U;
+			}
+		}
+		return 0;
+	}
+
+	/// The process' peak resident set size in bytes, from VmHWM in
+	/// /proc/self/status, or 0 if it is unavailable
+	inline std::size_t peak_rss( ) {
+		return status_bytes( "VmHWM:" );
+	}
+
+	/// The process' current resident set size in bytes, from VmRSS
+	inline std::size_t current_rss( ) {
+		return status_bytes( "VmRSS:" );
+	}
+
+	/// malloc's view of the heap, summed over its arenas
+	struct heap_stats {
+		/// Bytes obtained from the OS for the arenas, excluding chunks mapped
+		/// individually
+		std::size_t arena = 0;
+		/// Bytes free in the arenas, held rather than returned to the OS
+		std::size_t free = 0;
+	};
+
+	/// The current heap_stats, all 0 where mallinfo2 is unavailable
+	inline heap_stats heap( ) noexcept {
+		// __GLIBC_PREREQ only exists on glibc, so it cannot share the #if
+#if defined( __GLIBC__ )
+#if __GLIBC_PREREQ( 2, 33 )
+		auto const info = mallinfo2( );
+		return { info.arena, info.fordblks };
+#else
+		return { };
+#endif
+#else
+		return { };
+#endif
+	}
+
+	/// Reports the process' peak resident set size over its lifetime as the
+	/// peak_rss counter.  This is process wide, so only thread 0 resets and
+	/// reports it, and nothing is reported if the peak could not be reset.
+	class peak_rss_counter {
+		benchmark::State &m_state;
+		bool m_reset;
+
+	public:
+		explicit peak_rss_counter( benchmark::State &s )
+		  : m_state( s )
+		  , m_reset( s.thread_index( ) == 0 and reset_peak_rss( ) ) {}
+
+		peak_rss_counter( peak_rss_counter const & ) = delete;
+		peak_rss_counter &operator=( peak_rss_counter const & ) = delete;
+
+		~peak_rss_counter( ) {
+			if( not m_reset ) {
+				return;
+			}
+			m_state.counters["peak_rss"] =
+			  benchmark::Counter( static_cast<double>( peak_rss( ) ),
+			                      benchmark::Counter::kDefaults,
+			                      benchmark::Counter::kIs1024 );
+		}
+	};
+
+	/// Reports the memory a workload leaves behind, for kernels that free all
+	/// they allocate in each iteration.  Alongside peak_rss over its lifetime
+	/// it reports how far VmRSS and the free bytes malloc keeps in its arenas
+	/// grew from construction to destruction, as rss_after_free and heap_free,
+	/// and heap_fragmentation, the share of the arenas that is free but kept.
+	/// All are process wide, so only thread 0 reports them.
+	class footprint_counter {
+		benchmark::State &m_state;
+		peak_rss_counter m_peak;
+		std::size_t m_start_rss;
+		heap_stats m_start_heap;
+
+	public:
+		explicit footprint_counter( benchmark::State &s )
+		  : m_state( s )
+		  , m_peak( s )
+		  , m_start_rss( current_rss( ) )
+		  , m_start_heap( heap( ) ) {}
+
+		footprint_counter( footprint_counter const & ) = delete;
+		footprint_counter &operator=( footprint_counter const & ) = delete;
+
+		~footprint_counter( ) {
+			if( m_state.thread_index( ) != 0 ) {
+				return;
+			}
+			auto const bytes = []( double value ) {
+				return benchmark::Counter(
+				  value, benchmark::Counter::kDefaults, benchmark::Counter::kIs1024 );
+			};
+			m_state.counters["rss_after_free"] =
+			  bytes( static_cast<double>( current_rss( ) ) -
+			         static_cast<double>( m_start_rss ) );
+			auto const h = heap( );
+			if( h.arena == 0 ) {
+				return;
+			}
+			m_state.counters["heap_free"] =
+			  bytes( static_cast<double>( h.free ) -
+			         static_cast<double>( m_start_heap.free ) );
+			m_state.counters["heap_fragmentation"] =
+			  static_cast<double>( h.free ) / static_cast<double>( h.arena );
+		}
+	};
+} // namespace vtest
@@ -0,0 +1,301 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+/// Explicitly vectorized fill, iota and transform loops, for use as
+/// resize_and_overwrite callbacks.  Each instruction set gets its own copy of
+/// the loop, built with GCC vector extensions of that width and compiled for
+/// that target, and dispatch picks the widest one the CPU supports.
+namespace vtest::simd {
+	enum class isa {
+		/// The plain loop, vectorized or not as the compiler sees fit
+		scalar,
+		sse2,
+		avx2,
+		avx512,
+		/// The widest of the above that the CPU supports, chosen at runtime
+		dispatch
+	};
+
+	constexpr std::string_view isa_name( isa i ) noexcept {
+		switch( i ) {
+		case isa::scalar:
+			return "scalar";
+		case isa::sse2:
+			return "sse2";
+		case isa::avx2:
+			return "avx2";
+		case isa::avx512:
+			return "avx512";
+		case isa::dispatch:
+			return "dispatch";
+		}
+		return "";
+	}
+
+	/// Whether the CPU can run the loops built for i
+	inline bool supported( isa i ) noexcept {
+#if defined( __x86_64__ ) or defined( __i386__ )
+		switch( i ) {
+		case isa::sse2:
+			return __builtin_cpu_supports( "sse2" );
+		case isa::avx2:
+			return __builtin_cpu_supports( "avx2" );
+		case isa::avx512:
+			return __builtin_cpu_supports( "avx512f" ) and
+			       __builtin_cpu_supports( "avx512bw" );
+		default:
+			return true;
+		}
+#else
+		return i == isa::scalar or i == isa::dispatch;
+#endif
+	}
+
+	/// The widest instruction set supported
+	inline isa best_isa( ) noexcept {
+		for( auto i : { isa::avx512, isa::avx2, isa::sse2 } ) {
+			if( supported( i ) ) {
+				return i;
+			}
+		}
+		return isa::scalar;
+	}
+
+	namespace simd_impl {
+		/// The loops, Width bytes at a time.  They are always inlined into the
+		/// per instruction set entry points below, which set the target.
+		template<std::size_t Width, typename T>
+		[[gnu::always_inline]] inline void fill( T *out, std::size_t n, T value ) {
+			using V [[gnu::vector_size( Width )]] = T;
+			constexpr std::size_t lanes = Width / sizeof( T );
+			auto const v = V{ } + value;
+			std::size_t i = 0;
+			for( ; i + lanes <= n; i += lanes ) {
+				std::memcpy( out + i, &v, sizeof( V ) );
+			}
+			for( ; i < n; ++i ) {
+				out[i] = value;
+			}
+		}
+
+		template<std::size_t Width, typename T>
+		[[gnu::always_inline]] inline void iota( T *out, std::size_t n, T start ) {
+			using V [[gnu::vector_size( Width )]] = T;
+			constexpr std::size_t lanes = Width / sizeof( T );
+			auto v = V{ };
+			for( std::size_t l = 0; l < lanes; ++l ) {
+				v[l] = static_cast<T>( start + static_cast<T>( l ) );
+			}
+			auto const step = V{ } + static_cast<T>( lanes );
+			std::size_t i = 0;
+			for( ; i + lanes <= n; i += lanes ) {
+				std::memcpy( out + i, &v, sizeof( V ) );
+				v += step;
+			}
+			for( ; i < n; ++i ) {
+				out[i] = static_cast<T>( start + static_cast<T>( i ) );
+			}
+		}
+
+		/// out[i] = in[i] * a + b
+		template<std::size_t Width, typename T>
+		[[gnu::always_inline]] inline void
+		transform( T *out, T const *in, std::size_t n, T a, T b ) {
+			using V [[gnu::vector_size( Width )]] = T;
+			constexpr std::size_t lanes = Width / sizeof( T );
+			auto const va = V{ } + a;
+			auto const vb = V{ } + b;
+			std::size_t i = 0;
+			for( ; i + lanes <= n; i += lanes ) {
+				V v;
+				std::memcpy( &v, in + i, sizeof( V ) );
+				v = v * va + vb;
+				std::memcpy( out + i, &v, sizeof( V ) );
+			}
+			for( ; i < n; ++i ) {
+				out[i] = static_cast<T>( in[i] * a + b );
+			}
+		}
+
+		template<isa Isa>
+		struct ops;
+
+		template<>
+		struct ops<isa::scalar> {
+			template<typename T>
+			static void fill( T *out, std::size_t n, T value ) {
+				for( std::size_t i = 0; i < n; ++i ) {
+					out[i] = value;
+				}
+			}
+
+			template<typename T>
+			static void iota( T *out, std::size_t n, T start ) {
+				for( std::size_t i = 0; i < n; ++i ) {
+					out[i] = static_cast<T>( start + static_cast<T>( i ) );
+				}
+			}
+
+			template<typename T>
+			static void transform( T *out, T const *in, std::size_t n, T a, T b ) {
+				for( std::size_t i = 0; i < n; ++i ) {
+					out[i] = static_cast<T>( in[i] * a + b );
+				}
+			}
+		};
+
+#if defined( __x86_64__ ) or defined( __i386__ )
+		template<>
+		struct ops<isa::sse2> {
+			template<typename T>
+			[[gnu::target( "sse2" )]] static void
+			fill( T *out, std::size_t n, T value ) {
+				simd_impl::fill<16>( out, n, value );
+			}
+
+			template<typename T>
+			[[gnu::target( "sse2" )]] static void
+			iota( T *out, std::size_t n, T start ) {
+				simd_impl::iota<16>( out, n, start );
+			}
+
+			template<typename T>
+			[[gnu::target( "sse2" )]] static void
+			transform( T *out, T const *in, std::size_t n, T a, T b ) {
+				simd_impl::transform<16>( out, in, n, a, b );
+			}
+		};
+
+		template<>
+		struct ops<isa::avx2> {
+			template<typename T>
+			[[gnu::target( "avx2" )]] static void
+			fill( T *out, std::size_t n, T value ) {
+				simd_impl::fill<32>( out, n, value );
+			}
+
+			template<typename T>
+			[[gnu::target( "avx2" )]] static void
+			iota( T *out, std::size_t n, T start ) {
+				simd_impl::iota<32>( out, n, start );
+			}
+
+			template<typename T>
+			[[gnu::target( "avx2" )]] static void
+			transform( T *out, T const *in, std::size_t n, T a, T b ) {
+				simd_impl::transform<32>( out, in, n, a, b );
+			}
+		};
+
+		template<>
+		struct ops<isa::avx512> {
+			template<typename T>
+			[[gnu::target( "avx512f,avx512bw" )]] static void
+			fill( T *out, std::size_t n, T value ) {
+				simd_impl::fill<64>( out, n, value );
+			}
+
+			template<typename T>
+			[[gnu::target( "avx512f,avx512bw" )]] static void
+			iota( T *out, std::size_t n, T start ) {
+				simd_impl::iota<64>( out, n, start );
+			}
+
+			template<typename T>
+			[[gnu::target( "avx512f,avx512bw" )]] static void
+			transform( T *out, T const *in, std::size_t n, T a, T b ) {
+				simd_impl::transform<64>( out, in, n, a, b );
+			}
+		};
+#else
+		template<>
+		struct ops<isa::sse2> : ops<isa::scalar> {};
+		template<>
+		struct ops<isa::avx2> : ops<isa::scalar> {};
+		template<>
+		struct ops<isa::avx512> : ops<isa::scalar> {};
+#endif
+
+		/// Picks the ops of the best instruction set once per T
+		template<typename T>
+		struct dispatched {
+			using fill_fn = void ( * )( T *, std::size_t, T );
+			using iota_fn = void ( * )( T *, std::size_t, T );
+			using transform_fn = void ( * )( T *, T const *, std::size_t, T, T );
+
+			fill_fn fill;
+			iota_fn iota;
+			transform_fn transform;
+
+			template<isa Isa>
+			static constexpr dispatched make( ) noexcept {
+				return { &ops<Isa>::template fill<T>,
+				         &ops<Isa>::template iota<T>,
+				         &ops<Isa>::template transform<T> };
+			}
+
+			static dispatched const &get( ) noexcept {
+				static dispatched const result = [] {
+					switch( best_isa( ) ) {
+					case isa::avx512:
+						return make<isa::avx512>( );
+					case isa::avx2:
+						return make<isa::avx2>( );
+					case isa::sse2:
+						return make<isa::sse2>( );
+					default:
+						return make<isa::scalar>( );
+					}
+				}( );
+				return result;
+			}
+		};
+
+		template<>
+		struct ops<isa::dispatch> {
+			template<typename T>
+			static void fill( T *out, std::size_t n, T value ) {
+				dispatched<T>::get( ).fill( out, n, value );
+			}
+
+			template<typename T>
+			static void iota( T *out, std::size_t n, T start ) {
+				dispatched<T>::get( ).iota( out, n, start );
+			}
+
+			template<typename T>
+			static void transform( T *out, T const *in, std::size_t n, T a, T b ) {
+				dispatched<T>::get( ).transform( out, in, n, a, b );
+			}
+		};
+	} // namespace simd_impl
+
+	/// out[0, n) = value
+	template<isa Isa = isa::dispatch, typename T>
+	void fill( T *out, std::size_t n, T value ) {
+		simd_impl::ops<Isa>::fill( out, n, value );
+	}
+
+	/// out[i] = start + i, wrapping as T does
+	template<isa Isa = isa::dispatch, typename T>
+	void iota( T *out, std::size_t n, T start ) {
+		simd_impl::ops<Isa>::iota( out, n, start );
+	}
+
+	/// out[i] = in[i] * a + b
+	template<isa Isa = isa::dispatch, typename T>
+	void transform( T *out, T const *in, std::size_t n, T a, T b ) {
+		simd_impl::ops<Isa>::transform( out, in, n, a, b );
+	}
+} // namespace vtest::simd
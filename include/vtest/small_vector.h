@@ -0,0 +1,208 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace vtest {
+	/// Just enough of a vector with room for N elements inline, for the push,
+	/// resize and resize_and_overwrite kernels.  It moves to the heap, doubling,
+	/// once it outgrows the inline buffer and never moves back.
+	template<typename T, std::size_t N, typename Alloc = std::allocator<T>>
+	class small_vector {
+		static_assert( N > 0 );
+		using alloc_traits = std::allocator_traits<Alloc>;
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using allocator_type = Alloc;
+		using iterator = T *;
+		using const_iterator = T const *;
+
+	private:
+		[[no_unique_address]] Alloc m_alloc{ };
+		T *m_data = reinterpret_cast<T *>( m_inline );
+		std::size_t m_size = 0;
+		std::size_t m_capacity = N;
+		alignas( T ) std::byte m_inline[N * sizeof( T )];
+
+		[[nodiscard]] bool is_inline( ) const noexcept {
+			return m_data == reinterpret_cast<T const *>( m_inline );
+		}
+
+		void release( ) noexcept {
+			if( not is_inline( ) ) {
+				alloc_traits::deallocate( m_alloc, m_data, m_capacity );
+			}
+		}
+
+		/// Moves the elements into ptr, with room for new_capacity, and frees the
+		/// old storage.  If a move throws, ptr is left empty and the caller's.
+		void adopt( T *ptr, std::size_t new_capacity ) {
+			if constexpr( std::is_trivially_copyable_v<T> ) {
+				if( m_size != 0 ) {
+					std::memcpy( ptr, m_data, m_size * sizeof( T ) );
+				}
+			} else {
+				std::size_t i = 0;
+				try {
+					for( ; i < m_size; ++i ) {
+						std::construct_at( ptr + i, std::move_if_noexcept( m_data[i] ) );
+					}
+				} catch( ... ) {
+					std::destroy_n( ptr, i );
+					throw;
+				}
+				std::destroy_n( m_data, m_size );
+			}
+			release( );
+			m_data = ptr;
+			m_capacity = new_capacity;
+		}
+
+		void relocate( std::size_t new_capacity ) {
+			T *ptr = alloc_traits::allocate( m_alloc, new_capacity );
+			try {
+				adopt( ptr, new_capacity );
+			} catch( ... ) {
+				alloc_traits::deallocate( m_alloc, ptr, new_capacity );
+				throw;
+			}
+		}
+
+		void grow_for( std::size_t count ) {
+			if( count > m_capacity ) {
+				relocate( ( std::max )( count, 2 * m_capacity ) );
+			}
+		}
+
+	public:
+		small_vector( ) = default;
+		small_vector( small_vector const & ) = delete;
+		small_vector &operator=( small_vector const & ) = delete;
+
+		~small_vector( ) {
+			std::destroy_n( m_data, m_size );
+			release( );
+		}
+
+		void reserve( std::size_t count ) {
+			if( count > m_capacity ) {
+				relocate( count );
+			}
+		}
+
+		template<typename... Args>
+		T &emplace_back( Args &&...args ) {
+			if( m_size < m_capacity ) {
+				auto *result =
+				  std::construct_at( m_data + m_size, std::forward<Args>( args )... );
+				++m_size;
+				return *result;
+			}
+			// Construct the new element before moving the others, as args may
+			// refer to one of them
+			auto const new_capacity = 2 * m_capacity;
+			T *ptr = alloc_traits::allocate( m_alloc, new_capacity );
+			T *result = nullptr;
+			try {
+				result =
+				  std::construct_at( ptr + m_size, std::forward<Args>( args )... );
+				adopt( ptr, new_capacity );
+			} catch( ... ) {
+				if( result ) {
+					std::destroy_at( result );
+				}
+				alloc_traits::deallocate( m_alloc, ptr, new_capacity );
+				throw;
+			}
+			++m_size;
+			return *result;
+		}
+
+		void push_back( T const &value ) {
+			emplace_back( value );
+		}
+
+		void push_back( T &&value ) {
+			emplace_back( std::move( value ) );
+		}
+
+		void resize( std::size_t count ) {
+			if( count < m_size ) {
+				std::destroy( m_data + count, m_data + m_size );
+			} else {
+				grow_for( count );
+				std::uninitialized_value_construct( m_data + m_size, m_data + count );
+			}
+			m_size = count;
+		}
+
+		void clear( ) noexcept {
+			std::destroy_n( m_data, m_size );
+			m_size = 0;
+		}
+
+		/// op( data, count ) or op( data, count, allocator ) constructs the first
+		/// m elements of raw storage and returns m.  Existing elements are
+		/// destroyed first.
+		template<typename Op>
+		void resize_and_overwrite( std::size_t count, Op op ) {
+			clear( );
+			grow_for( count );
+			if constexpr( std::is_invocable_v<Op &, T *, std::size_t, Alloc> ) {
+				m_size = op( m_data, count, m_alloc );
+			} else {
+				m_size = op( m_data, count );
+			}
+		}
+
+		[[nodiscard]] T *data( ) noexcept {
+			return m_data;
+		}
+
+		[[nodiscard]] T const *data( ) const noexcept {
+			return m_data;
+		}
+
+		[[nodiscard]] iterator begin( ) noexcept {
+			return m_data;
+		}
+
+		[[nodiscard]] iterator end( ) noexcept {
+			return m_data + m_size;
+		}
+
+		[[nodiscard]] std::size_t size( ) const noexcept {
+			return m_size;
+		}
+
+		[[nodiscard]] std::size_t capacity( ) const noexcept {
+			return m_capacity;
+		}
+
+		[[nodiscard]] Alloc get_allocator( ) const noexcept {
+			return m_alloc;
+		}
+	};
+
+	/// The inline capacity of a small_vector, 0 for other containers
+	template<typename Vec>
+	inline constexpr std::size_t inline_capacity_v = 0;
+
+	template<typename T, std::size_t N, typename Alloc>
+	inline constexpr std::size_t inline_capacity_v<small_vector<T, N, Alloc>> =
+	  N;
+} // namespace vtest
@@ -0,0 +1,109 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include "perf_counters.h"
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace vtest {
+	/// Nanoseconds the calling thread has spent in pause_timing, so that
+	/// reporters timing the benchmark loop themselves can leave it out
+	inline double &paused_ns( ) noexcept {
+		thread_local double result = 0.0;
+		return result;
+	}
+
+	/// Pauses the benchmark timer and the calling thread's perf_counters for
+	/// its lifetime and adds the time to paused_ns( )
+	class pause_timing {
+		benchmark::State &m_state;
+		std::chrono::steady_clock::time_point m_start;
+
+	public:
+		explicit pause_timing( benchmark::State &s )
+		  : m_state( s ) {
+			m_state.PauseTiming( );
+			pause_perf_counters( );
+			m_start = std::chrono::steady_clock::now( );
+		}
+
+		pause_timing( pause_timing const & ) = delete;
+		pause_timing &operator=( pause_timing const & ) = delete;
+
+		~pause_timing( ) {
+			paused_ns( ) += std::chrono::duration<double, std::nano>(
+			                  std::chrono::steady_clock::now( ) - m_start )
+			                  .count( );
+			resume_perf_counters( );
+			m_state.ResumeTiming( );
+		}
+	};
+
+	/// Reports elements processed, so items_per_second is the aggregate rate
+	/// over all threads, and latency_ns, the mean time per iteration seen by
+	/// each thread less any pause_timing
+	class throughput {
+		benchmark::State &m_state;
+		std::size_t m_elements;
+		std::chrono::steady_clock::time_point m_start;
+		double m_paused_start;
+
+	public:
+		throughput( benchmark::State &s, std::size_t elements ) noexcept
+		  : m_state( s )
+		  , m_elements( elements )
+		  , m_start( std::chrono::steady_clock::now( ) )
+		  , m_paused_start( paused_ns( ) ) {}
+
+		throughput( throughput const & ) = delete;
+		throughput &operator=( throughput const & ) = delete;
+
+		~throughput( ) {
+			auto const iterations = m_state.iterations( );
+			if( iterations == 0 ) {
+				return;
+			}
+			m_state.SetItemsProcessed(
+			  static_cast<std::int64_t>( iterations ) *
+			  static_cast<std::int64_t>( m_elements ) );
+			auto const elapsed = std::chrono::duration<double, std::nano>(
+			                       std::chrono::steady_clock::now( ) - m_start )
+			                       .count( ) -
+			                     ( paused_ns( ) - m_paused_start );
+			m_state.counters["latency_ns"] =
+			  benchmark::Counter( elapsed / static_cast<double>( iterations ),
+			                      benchmark::Counter::kAvgThreads );
+		}
+	};
+
+	/// Reports bytes processed, so bytes_per_second is the aggregate
+	/// bandwidth over all threads
+	class bandwidth {
+		benchmark::State &m_state;
+		std::size_t m_bytes;
+
+	public:
+		bandwidth( benchmark::State &s, std::size_t bytes ) noexcept
+		  : m_state( s )
+		  , m_bytes( bytes ) {}
+
+		bandwidth( bandwidth const & ) = delete;
+		bandwidth &operator=( bandwidth const & ) = delete;
+
+		~bandwidth( ) {
+			m_state.SetBytesProcessed( static_cast<std::int64_t>(
+			                             m_state.iterations( ) ) *
+			                           static_cast<std::int64_t>( m_bytes ) );
+		}
+	};
+} // namespace vtest
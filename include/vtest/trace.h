@@ -0,0 +1,279 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/// Traces of vector operations, replayed against any vector type.  A trace
+/// file is a trace_header followed by header.entries trace_entry records, in
+/// native byte order.
+namespace vtest {
+	enum class trace_op : std::uint8_t {
+		/// Construct an empty vector in slot
+		create,
+		reserve,
+		/// push_back count elements
+		push_back,
+		resize,
+		clear,
+		/// Destroy the vector in slot
+		destroy
+	};
+
+	struct trace_entry {
+		trace_op op;
+		std::uint8_t reserved[3]{ };
+		std::uint32_t slot;
+		std::uint64_t count;
+	};
+	static_assert( sizeof( trace_entry ) == 16 );
+
+	struct trace_header {
+		char magic[4] = { 'V', 'T', 'R', 'C' };
+		std::uint32_t version = 1;
+		/// The number of vectors that can be live at once
+		std::uint32_t slots = 0;
+		std::uint32_t reserved = 0;
+		std::uint64_t entries = 0;
+	};
+	static_assert( sizeof( trace_header ) == 24 );
+
+	struct trace {
+		std::uint32_t slots = 0;
+		std::vector<trace_entry> entries{ };
+
+		/// The elements push_back and resize add over the trace
+		[[nodiscard]] std::size_t elements( ) const noexcept {
+			auto result = std::size_t{ 0 };
+			for( auto const &e : entries ) {
+				if( e.op == trace_op::push_back or e.op == trace_op::resize ) {
+					result += e.count;
+				}
+			}
+			return result;
+		}
+	};
+
+	inline void write_trace( std::string const &path, trace const &t ) {
+		auto out = std::ofstream( path, std::ios::binary );
+		auto const header = trace_header{ .slots = t.slots,
+		                                  .entries = t.entries.size( ) };
+		out.write( reinterpret_cast<char const *>( &header ), sizeof( header ) );
+		out.write( reinterpret_cast<char const *>( t.entries.data( ) ),
+		           static_cast<std::streamsize>( t.entries.size( ) *
+		                                         sizeof( trace_entry ) ) );
+		if( not out ) {
+			throw std::runtime_error( "Could not write trace " + path );
+		}
+	}
+
+	inline trace read_trace( std::string const &path ) {
+		auto in = std::ifstream( path, std::ios::binary );
+		auto header = trace_header{ };
+		in.read( reinterpret_cast<char *>( &header ), sizeof( header ) );
+		if( not in or not std::equal( header.magic,
+		                              header.magic + 4,
+		                              trace_header{ }.magic ) ) {
+			throw std::runtime_error( path + " is not a vtest trace" );
+		}
+		if( header.version != trace_header{ }.version ) {
+			throw std::runtime_error( path + " has an unsupported trace version" );
+		}
+		auto result = trace{ .slots = header.slots,
+		                     .entries = std::vector<trace_entry>(
+		                       static_cast<std::size_t>( header.entries ) ) };
+		in.read( reinterpret_cast<char *>( result.entries.data( ) ),
+		         static_cast<std::streamsize>( result.entries.size( ) *
+		                                       sizeof( trace_entry ) ) );
+		if( not in ) {
+			throw std::runtime_error( path + " is truncated" );
+		}
+		// replay assumes every op but create is on a live vector, so check that
+		// here rather than in the timed loop
+		auto live = std::vector<bool>( result.slots );
+		for( std::size_t i = 0; i < result.entries.size( ); ++i ) {
+			auto const &e = result.entries[i];
+			if( e.slot >= result.slots or e.op > trace_op::destroy ) {
+				throw std::runtime_error( path + " has an invalid entry at " +
+				                          std::to_string( i ) );
+			}
+			if( ( e.op == trace_op::create ) == live[e.slot] ) {
+				throw std::runtime_error(
+				  path + " entry " + std::to_string( i ) +
+				  ( e.op == trace_op::create ? " creates a live vector"
+				                             : " uses a vector that does not exist" ) );
+			}
+			live[e.slot] = e.op != trace_op::destroy;
+		}
+		return result;
+	}
+
+	/// Replays traces against Vec, keeping the slots between replays
+	template<typename Vec>
+	class trace_player {
+		std::vector<std::optional<Vec>> m_slots;
+
+	public:
+		explicit trace_player( std::uint32_t slots )
+		  : m_slots( slots ) {}
+
+		void replay( std::span<trace_entry const> entries ) {
+			using T = typename Vec::value_type;
+			for( auto const &e : entries ) {
+				auto &slot = m_slots[e.slot];
+				switch( e.op ) {
+				case trace_op::create:
+					slot.emplace( );
+					break;
+				case trace_op::reserve:
+					slot->reserve( e.count );
+					break;
+				case trace_op::push_back:
+					for( std::uint64_t i = 0; i < e.count; ++i ) {
+						slot->push_back( T( i ) );
+					}
+					break;
+				case trace_op::resize:
+					slot->resize( e.count );
+					break;
+				case trace_op::clear:
+					slot->clear( );
+					break;
+				case trace_op::destroy:
+					slot.reset( );
+					break;
+				}
+			}
+			// Traces are meant to destroy everything they create, but do not
+			// carry live vectors into the next replay if they do not
+			for( auto &slot : m_slots ) {
+				slot.reset( );
+			}
+		}
+	};
+
+	enum class size_distribution { log_normal, zipf };
+
+	struct trace_config {
+		size_distribution distribution = size_distribution::log_normal;
+		/// Vectors created over the whole trace
+		std::size_t vectors = 100'000;
+		/// Vectors live at once; a random live one is destroyed to make room
+		std::uint32_t max_live = 64;
+		/// Parameters of the natural log of the final size
+		double log_normal_mu = 1.5;
+		double log_normal_sigma = 2.0;
+		/// P( size = k ) is proportional to 1 / k^zipf_s for k in [1, zipf_max]
+		double zipf_s = 1.2;
+		std::uint64_t zipf_max = 1U << 16U;
+		std::uint64_t max_size = 1U << 24U;
+		double reserve_probability = 0.1;
+		/// Fill with one resize rather than push_back runs
+		double resize_probability = 0.1;
+		/// Clear and fill a second time before the vector is destroyed
+		double clear_probability = 0.1;
+		std::uint64_t seed = 42;
+	};
+
+	/// A trace of config.vectors vectors, each created, filled to a size drawn
+	/// from the configured distribution in one or more push_back runs or a
+	/// resize, and destroyed at a random later point
+	inline trace generate_trace( trace_config const &config ) {
+		auto rng = std::mt19937_64( config.seed );
+		auto const max_live = ( std::max )( config.max_live, std::uint32_t{ 1 } );
+		auto log_normal = std::lognormal_distribution<double>(
+		  config.log_normal_mu, config.log_normal_sigma );
+		auto zipf = std::discrete_distribution<std::uint64_t>( );
+		if( config.distribution == size_distribution::zipf ) {
+			auto weights = std::vector<double>( config.zipf_max );
+			for( std::size_t k = 0; k < weights.size( ); ++k ) {
+				weights[k] =
+				  1.0 / std::pow( static_cast<double>( k + 1 ), config.zipf_s );
+			}
+			zipf = std::discrete_distribution<std::uint64_t>( weights.begin( ),
+			                                                  weights.end( ) );
+		}
+		auto const draw_size = [&]( ) -> std::uint64_t {
+			auto const size =
+			  config.distribution == size_distribution::zipf
+			    ? zipf( rng ) + 1
+			    : static_cast<std::uint64_t>( std::llround( log_normal( rng ) ) );
+			return ( std::min )( size, config.max_size );
+		};
+		auto chance = std::bernoulli_distribution( );
+		auto const happens = [&]( double p ) {
+			return chance( rng, std::bernoulli_distribution::param_type( p ) );
+		};
+
+		auto result = trace{ .slots = max_live };
+		auto const emit = [&]( trace_op op, std::uint32_t slot, std::uint64_t n ) {
+			result.entries.push_back(
+			  trace_entry{ .op = op, .slot = slot, .count = n } );
+		};
+		auto const fill = [&]( std::uint32_t slot, std::uint64_t size ) {
+			if( happens( config.resize_probability ) ) {
+				emit( trace_op::resize, slot, size );
+				return;
+			}
+			// A few runs of random lengths, as when appending batches
+			while( size > 0 ) {
+				auto const run =
+				  std::uniform_int_distribution<std::uint64_t>( 1, size )( rng );
+				emit( trace_op::push_back, slot, run );
+				size -= run;
+			}
+		};
+
+		auto live = std::vector<std::uint32_t>( );
+		auto free_slots = std::vector<std::uint32_t>( );
+		for( std::uint32_t slot = max_live; slot > 0; --slot ) {
+			free_slots.push_back( slot - 1 );
+		}
+		auto const destroy_at = [&]( std::size_t index ) {
+			emit( trace_op::destroy, live[index], 0 );
+			free_slots.push_back( live[index] );
+			live[index] = live.back( );
+			live.pop_back( );
+		};
+		for( std::size_t v = 0; v < config.vectors; ++v ) {
+			if( free_slots.empty( ) ) {
+				destroy_at( std::uniform_int_distribution<std::size_t>(
+				  0, live.size( ) - 1 )( rng ) );
+			}
+			auto const slot = free_slots.back( );
+			free_slots.pop_back( );
+			live.push_back( slot );
+
+			auto const size = draw_size( );
+			emit( trace_op::create, slot, 0 );
+			if( happens( config.reserve_probability ) ) {
+				emit( trace_op::reserve, slot, size );
+			}
+			fill( slot, size );
+			if( happens( config.clear_probability ) ) {
+				emit( trace_op::clear, slot, 0 );
+				fill( slot, draw_size( ) );
+			}
+		}
+		while( not live.empty( ) ) {
+			destroy_at( live.size( ) - 1 );
+		}
+		return result;
+	}
+} // namespace vtest
@@ -0,0 +1,158 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+// Checks the report reader and the Mann-Whitney U test vtest_compare uses
+// against fixed inputs.
+
+#include "vtest/bench_json.h"
+#include "vtest/mann_whitney.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+namespace {
+	int failures = 0;
+
+	void check( bool ok, std::string_view what ) {
+		if( not ok ) {
+			std::cerr << "FAILED: " << what << '\n';
+			++failures;
+		}
+	}
+
+	bool near( double a, double b, double tolerance = 1e-6 ) {
+		return std::abs( a - b ) <= tolerance;
+	}
+
+	// Trimmed from a Google Benchmark 1.7.1 report, with the values it writes
+	// for counters that are not finite
+	constexpr std::string_view report = R"({
+  "context": {
+    "date": "2024-01-01T00:00:00+00:00",
+    "num_cpus": 8,
+    "caches": [ { "type": "Data", "level": 1, "size": 32768 } ],
+    "library_build_type": "release",
+    "json_escape": "a\"b\\cA"
+  },
+  "benchmarks": [
+    {
+      "name": "bench_vec_pb<std::vector<int>>/1024",
+      "family_index": 0,
+      "run_name": "bench_vec_pb<std::vector<int>>/1024",
+      "run_type": "iteration",
+      "repetitions": 2,
+      "repetition_index": 0,
+      "threads": 1,
+      "iterations": 1000,
+      "real_time": 1.5e+00,
+      "cpu_time": 1.25,
+      "time_unit": "us",
+      "bytes_per_second": Infinity,
+      "ratio": NaN,
+      "delta": -Infinity
+    },
+    {
+      "name": "bench_vec_pb<std::vector<int>>/1024",
+      "run_name": "bench_vec_pb<std::vector<int>>/1024",
+      "run_type": "iteration",
+      "real_time": 2000,
+      "cpu_time": 1800,
+      "time_unit": "ns"
+    },
+    {
+      "name": "bench_vec_pb<std::vector<int>>/1024_mean",
+      "run_name": "bench_vec_pb<std::vector<int>>/1024",
+      "run_type": "aggregate",
+      "aggregate_name": "mean",
+      "real_time": 1750,
+      "cpu_time": 1525,
+      "time_unit": "ns"
+    },
+    {
+      "name": "bench_failed/8",
+      "run_name": "bench_failed/8",
+      "run_type": "iteration",
+      "error_occurred": true,
+      "error_message": "skipped"
+    }
+  ]
+})";
+
+	void test_parse( ) {
+		auto const runs = vtest::parse_bench_json( report, "report" );
+		check( runs.size( ) == 2, "aggregate and error runs are skipped" );
+		if( runs.size( ) != 2 ) {
+			return;
+		}
+		check( runs[0].run_name == "bench_vec_pb<std::vector<int>>/1024",
+		       "run_name" );
+		check( near( runs[0].real_time_ns, 1500.0 ), "real_time in us" );
+		check( near( runs[0].cpu_time_ns, 1250.0 ), "cpu_time in us" );
+		check( near( runs[1].real_time_ns, 2000.0 ), "real_time in ns" );
+		check( near( runs[1].cpu_time_ns, 1800.0 ), "cpu_time in ns" );
+	}
+
+	void test_parse_error( ) {
+		auto threw = false;
+		try {
+			(void)vtest::parse_bench_json( R"({ "benchmarks": [ { "x": inf } ] })",
+			                               "bad" );
+		} catch( std::exception const &ex ) {
+			threw = std::string_view( ex.what( ) ).starts_with( "bad: " );
+		}
+		check( threw, "unknown literals are rejected with the source" );
+	}
+
+	void test_mann_whitney( ) {
+		{
+			auto const a = std::vector<double>{ 1, 2, 3 };
+			auto const b = std::vector<double>{ 4, 5, 6 };
+			auto const r = vtest::mann_whitney_u( a, b );
+			check( near( r.u, 0.0 ) and near( r.p, 0.1 ), "exact 3 vs 3" );
+		}
+		{
+			auto const a = std::vector<double>{ 1, 2, 3, 4, 5 };
+			auto const b = std::vector<double>{ 6, 7, 8, 9, 10 };
+			auto const r = vtest::mann_whitney_u( a, b );
+			check( near( r.u, 0.0 ) and near( r.p, 0.00793651 ), "exact 5 vs 5" );
+			auto const s = vtest::mann_whitney_u( b, a );
+			check( near( s.u, 25.0 ) and near( s.p, r.p ), "symmetric" );
+		}
+		{
+			auto const a = std::vector<double>{ 1, 1, 2, 3, 5 };
+			auto const b = std::vector<double>{ 2, 4, 6, 6, 7 };
+			auto const r = vtest::mann_whitney_u( a, b );
+			check( near( r.u, 3.5 ) and near( r.p, 0.0731398 ),
+			       "normal approximation with ties" );
+		}
+		{
+			auto const b = std::vector<double>{ 1, 2 };
+			auto const r = vtest::mann_whitney_u( { }, b );
+			check( near( r.p, 1.0 ), "empty sample" );
+		}
+	}
+} // namespace
+
+int main( ) {
+	try {
+		test_parse( );
+		test_parse_error( );
+		test_mann_whitney( );
+	} catch( std::exception const &ex ) {
+		std::cerr << "FAILED: " << ex.what( ) << '\n';
+		return EXIT_FAILURE;
+	}
+	if( failures != 0 ) {
+		return EXIT_FAILURE;
+	}
+	std::cout << "all passed\n";
+	return EXIT_SUCCESS;
+}
@@ -10,16 +10,365 @@
 #include <daw/deprecated/daw_vector.h>
 #include <daw/vector.h>
 
+#include "vtest/arena.h"
+#include "vtest/cache_mode.h"
+#include "vtest/counting_alloc.h"
+#include "vtest/default_init.h"
+#include "vtest/element_types.h"
+#include "vtest/growth.h"
+#include "vtest/iterators.h"
+#include "vtest/mmap_alloc.h"
+#include "vtest/parallel_fill.h"
+#include "vtest/perf_counters.h"
+#include "vtest/register.h"
+#include "vtest/rusage.h"
+#include "vtest/simd_fill.h"
+#include "vtest/small_vector.h"
+#include "vtest/throughput.h"
+#include "vtest/trace.h"
+
 #include <benchmark/benchmark.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
 #include <vector>
 
+// The implementation daw/vector.h replaced.  Define VTEST_DEPRECATED_VECTOR
+// when building against a header_libraries revision that names it differently.
+#if not defined( VTEST_DEPRECATED_VECTOR )
+#define VTEST_DEPRECATED_VECTOR daw::deprecated::vector
+#endif
+
+template<typename T>
+using daw_vec = daw::vector<T, std::allocator<T>>;
+
+template<typename T>
+using old_daw_vec = VTEST_DEPRECATED_VECTOR<T, std::allocator<T>>;
+
+template<typename T>
+using std_vec = std::vector<T, std::allocator<T>>;
+
+template<typename T>
+using counted_daw_vec = daw::vector<T, vtest::counting_alloc<T>>;
+
+template<typename T>
+using counted_std_vec = std::vector<T, vtest::counting_alloc<T>>;
+
+// resize( n ) default-initialises, leaving trivial elements unwritten
+template<typename T>
+using default_init_std_vec = std::vector<T, vtest::default_init_alloc<T>>;
+
+template<typename T>
+using default_init_daw_vec = daw::vector<T, vtest::default_init_alloc<T>>;
+
+// realloc based models of alternative growth policies
+template<typename T>
+using realloc_x1_5 = vtest::realloc_vector<T, vtest::geometric_growth<3, 2>>;
+
+template<typename T>
+using realloc_phi =
+  vtest::realloc_vector<T, vtest::geometric_growth<1618, 1000>>;
+
+template<typename T>
+using realloc_x2 = vtest::realloc_vector<T, vtest::geometric_growth<2, 1>>;
+
+template<typename T>
+using realloc_capped =
+  vtest::realloc_vector<T, vtest::capped_growth<std::size_t{ 1 } << 16U>>;
+
+template<typename T>
+using realloc_x1_5_init64 =
+  vtest::realloc_vector<T, vtest::geometric_growth<3, 2, 64>>;
+
+template<typename T>
+using realloc_x2_init64 =
+  vtest::realloc_vector<T, vtest::geometric_growth<2, 1, 64>>;
+
+template<typename T>
+using daw_mmap_vec = daw::vector<T, daw::MMapAlloc<T>>;
+
+template<typename T>
+using counted_daw_mmap_vec =
+  daw::vector<T, vtest::counting_alloc<T, daw::MMapAlloc<T>>>;
+
+// mmap backed growth by copying into a new mapping vs by mremap
+template<typename T>
+using mmap_copy_x2 = vtest::realloc_vector<T,
+                                           vtest::geometric_growth<2, 1>,
+                                           vtest::mmap_copy_realloc<>>;
+
+template<typename T>
+using mremap_x2 = vtest::realloc_vector<T,
+                                        vtest::geometric_growth<2, 1>,
+                                        vtest::mremap_realloc<>>;
+
+template<typename T>
+using mmap_populate_vec =
+  daw::vector<T, vtest::mmap_alloc<T, vtest::mmap_hint::populate>>;
+
+template<typename T>
+using mmap_huge_vec =
+  daw::vector<T, vtest::mmap_alloc<T, vtest::mmap_hint::huge_pages>>;
+
+template<typename T>
+using pmr_mono_vec =
+  daw::vector<T, vtest::pmr_alloc<T, std::pmr::monotonic_buffer_resource>>;
+
+template<typename T>
+using pmr_pool_vec =
+  daw::vector<T, vtest::pmr_alloc<T, std::pmr::unsynchronized_pool_resource>>;
+
+template<typename T>
+using arena_vec = daw::vector<T, vtest::arena_alloc<T>>;
+
+// Inline capacity at the sizes most vectors are
+template<typename T>
+using small_vec4 = vtest::small_vector<T, 4>;
+
 template<typename T>
+using small_vec16 = vtest::small_vector<T, 16>;
+
+#if defined( __cpp_lib_string_resize_and_overwrite )
+template<typename T>
+using std_str = std::basic_string<T>;
+#endif
+
+namespace vtest {
+	/// Which baseline, if any, a container's timings are recorded as
+	enum class baseline { none, std_container, deprecated_daw, current_daw };
+
+	template<typename Vec>
+	inline constexpr baseline baseline_kind_v = baseline::none;
+
+	// Only containers on std::allocator are baselines, so that the counted and
+	// other allocator variants do not overwrite the timings of the plain ones
+	template<typename T>
+	inline constexpr baseline
+	  baseline_kind_v<std::vector<T, std::allocator<T>>> =
+	    baseline::std_container;
+
+	template<typename CharT, typename Traits>
+	inline constexpr baseline
+	  baseline_kind_v<std::basic_string<CharT, Traits, std::allocator<CharT>>> =
+	    baseline::std_container;
+
+	template<typename T>
+	inline constexpr baseline
+	  baseline_kind_v<VTEST_DEPRECATED_VECTOR<T, std::allocator<T>>> =
+	    baseline::deprecated_daw;
+
+	template<typename T>
+	inline constexpr baseline
+	  baseline_kind_v<daw::vector<T, std::allocator<T>>> = baseline::current_daw;
+
+	/// Calls Vec::resize_and_overwrite when the container has one.  Otherwise,
+	/// as with std::vector, falls back to what callers have to write today:
+	/// resize( n ), fill through data( ), then trim to the returned size.  For
+	/// non-trivially destructible T the elements are destroyed before op runs,
+	/// so op sees raw storage just as it would with resize_and_overwrite.
+	template<typename Vec, typename Op>
+	void resize_and_overwrite( Vec &v, std::size_t n, Op op ) {
+		if constexpr( requires { v.resize_and_overwrite( n, op ); } ) {
+			v.resize_and_overwrite( n, op );
+		} else {
+			using T = typename Vec::value_type;
+			using Alloc = typename Vec::allocator_type;
+			v.resize( n );
+			if constexpr( not std::is_trivially_destructible_v<T> ) {
+				std::destroy_n( v.data( ), n );
+			}
+			std::size_t m = 0;
+			if constexpr( std::is_invocable_v<Op &, T *, std::size_t, Alloc> ) {
+				m = op( v.data( ), n, v.get_allocator( ) );
+			} else {
+				m = op( v.data( ), n );
+			}
+			if constexpr( not std::is_trivially_destructible_v<T> ) {
+				std::uninitialized_value_construct( v.data( ) + m, v.data( ) + n );
+			}
+			v.resize( m );
+		}
+	}
+
+	/// Nanoseconds per iteration of the baseline runs, keyed by
+	/// kernel/element type/size
+	inline std::map<std::string, double> &baselines( baseline kind ) {
+		static auto result = std::array<std::map<std::string, double>, 3>{ };
+		return result[static_cast<std::size_t>( kind ) - 1];
+	}
+
+	/// The latest speedup_vs_daw of each small_vector run by size, keyed by
+	/// kernel/container/threads
+	inline std::map<std::string, std::map<std::int64_t, double>> &
+	inline_speedups( ) {
+		static auto result =
+		  std::map<std::string, std::map<std::int64_t, double>>{ };
+		return result;
+	}
+
+	/// How much slower than the deprecated daw::vector a run may be before it
+	/// is labelled a regression.  Set VTEST_REGRESSION_THRESHOLD to override
+	/// the default of 0.05, i.e. 5%.
+	inline double regression_threshold( ) {
+		static double const result = [] {
+			char const *env = std::getenv( "VTEST_REGRESSION_THRESHOLD" );
+			return env ? std::strtod( env, nullptr ) : 0.05;
+		}( );
+		return result;
+	}
+
+	/// Times the benchmark loop and pairs each run with the baseline runs of the
+	/// same kernel, element type, size and thread count, as seen by thread 0.
+	/// Baselines must be registered first: std, then deprecated, then
+	/// daw::vector on std::allocator.  Later runs report speedup_vs_std,
+	/// speedup_vs_old and speedup_vs_daw as baseline time / own time, so values
+	/// above 1 favour the run.  daw::vector on std::allocator is labelled
+	/// REGRESSION when slower than the deprecated daw::vector by more than
+	/// regression_threshold( ).
+	/// It times from construction, so build untimed inputs before it.  Time
+	/// spent in pause_timing is left out.  Runs in a cache_mode other than warm
+	/// are compared with baselines in the same mode.
+	/// small_vector runs also report crossover_n, the smallest size so far at
+	/// which they were slower than daw::vector, once there is one.
+	template<typename Vec>
+	class baseline_compare {
+		benchmark::State &m_state;
+		std::string m_kernel;
+		std::string m_key;
+		std::chrono::steady_clock::time_point m_start;
+		double m_paused_start;
+
+	public:
+		baseline_compare( benchmark::State &s,
+		                  char const *kernel,
+		                  cache_mode mode = cache_mode::warm )
+		  : m_state( s )
+		  , m_kernel( mode == cache_mode::warm
+		                ? std::string( kernel )
+		                : std::string( kernel ) + '_' +
+		                    std::string( cache_mode_name( mode ) ) )
+		  , m_key( m_kernel + '/' + typeid( typename Vec::value_type ).name( ) +
+		           '/' + std::to_string( s.range( 0 ) ) + '/' +
+		           std::to_string( s.threads( ) ) )
+		  , m_start( std::chrono::steady_clock::now( ) )
+		  , m_paused_start( paused_ns( ) ) {}
+
+		baseline_compare( baseline_compare const & ) = delete;
+		baseline_compare &operator=( baseline_compare const & ) = delete;
+
+		~baseline_compare( ) {
+			if( m_state.thread_index( ) != 0 or m_state.iterations( ) == 0 ) {
+				return;
+			}
+			auto const elapsed = std::chrono::duration<double, std::nano>(
+			                       std::chrono::steady_clock::now( ) - m_start )
+			                       .count( ) -
+			                     ( paused_ns( ) - m_paused_start );
+			auto const per_iter =
+			  elapsed / static_cast<double>( m_state.iterations( ) );
+			if( per_iter <= 0.0 ) {
+				return;
+			}
+			constexpr auto kind = baseline_kind_v<Vec>;
+			if constexpr( kind != baseline::none ) {
+				baselines( kind )[m_key] = per_iter;
+			}
+			if constexpr( kind == baseline::std_container ) {
+				return;
+			}
+			auto const &std_times = baselines( baseline::std_container );
+			if( auto pos = std_times.find( m_key ); pos != std_times.end( ) ) {
+				m_state.counters["speedup_vs_std"] = pos->second / per_iter;
+			}
+			if constexpr( kind != baseline::deprecated_daw ) {
+				auto const &old_times = baselines( baseline::deprecated_daw );
+				if( auto pos = old_times.find( m_key ); pos != old_times.end( ) ) {
+					auto const speedup = pos->second / per_iter;
+					m_state.counters["speedup_vs_old"] = speedup;
+					// Only daw::vector on std::allocator stands in for the new vector;
+					// other containers differ from the deprecated one in more than that
+					if constexpr( kind == baseline::current_daw ) {
+						if( speedup < 1.0 - regression_threshold( ) ) {
+							m_state.SetLabel( "REGRESSION" );
+						}
+					}
+				}
+			}
+			if constexpr( kind == baseline::none ) {
+				auto const &daw_times = baselines( baseline::current_daw );
+				if( auto pos = daw_times.find( m_key ); pos != daw_times.end( ) ) {
+					auto const speedup = pos->second / per_iter;
+					m_state.counters["speedup_vs_daw"] = speedup;
+					if constexpr( inline_capacity_v<Vec> > 0 ) {
+						report_crossover( speedup );
+					}
+				}
+			}
+		}
+
+	private:
+		void report_crossover( double speedup_vs_daw ) {
+			auto const family = m_kernel + '/' + typeid( Vec ).name( ) + '/' +
+			                    std::to_string( m_state.threads( ) );
+			// Google Benchmark may run each size more than once while it settles
+			// on an iteration count, so only the last run of a size counts
+			auto &speedups = inline_speedups( )[family];
+			speedups[m_state.range( 0 )] = speedup_vs_daw;
+			for( auto const &[n, speedup] : speedups ) {
+				if( speedup < 1.0 ) {
+					m_state.counters["crossover_n"] = static_cast<double>( n );
+					return;
+				}
+			}
+		}
+	};
+} // namespace vtest
+
+/// Reports nominal_bytes_written, the bytes per element a kernel that sizes a
+/// trivial vector and then writes each element once is expected to store:
+/// the write alone when the sizing path is one that should leave the storage
+/// as it is, or the write plus the zeroing when it value-initialises.  It
+/// follows from which path the container takes, not from what was measured,
+/// so a resize_and_overwrite that zeroes anyway still reports one write.
+template<typename Vec>
+static void report_nominal_bytes_written( benchmark::State &s, bool zeroes ) {
+	using T = typename Vec::value_type;
+	if constexpr( std::is_trivially_default_constructible_v<T> ) {
+		s.counters["nominal_bytes_written"] =
+		  static_cast<double>( sizeof( T ) * ( zeroes ? 2 : 1 ) );
+	}
+}
+
+template<typename Vec, vtest::cache_mode Mode = vtest::cache_mode::warm>
 static void bench_vec_pb( benchmark::State &s ) {
+	using T = typename Vec::value_type;
 	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__, Mode );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
+	auto const rate = vtest::throughput( s, n );
 	for( auto _ : s ) {
+		vtest::prepare_iteration<Mode>( s );
 		[=]( ) __attribute__( ( noinline ) ) {
-			daw::vector<T, std::allocator<T>> v;
+			Vec v;
 			benchmark::DoNotOptimize( &v );
 			for( std::size_t i = 0; i < n; ++i ) {
 				v.push_back( T( i ) );
@@ -30,12 +379,20 @@ static void bench_vec_pb( benchmark::State &s ) {
 	}
 }
 
-template<typename T>
+template<typename Vec, vtest::cache_mode Mode = vtest::cache_mode::warm>
 static void bench_vec_resize_data_ptr( benchmark::State &s ) {
+	using T = typename Vec::value_type;
 	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__, Mode );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
+	report_nominal_bytes_written<Vec>(
+	  s, not vtest::is_default_init_alloc_v<typename Vec::allocator_type> );
 	for( auto _ : s ) {
+		vtest::prepare_iteration<Mode>( s );
 		[=]( ) __attribute__( ( noinline ) ) {
-			daw::vector<T, std::allocator<T>> v;
+			Vec v;
 			benchmark::DoNotOptimize( &v );
 			v.resize( n );
 			T *ptr = v.data( );
@@ -48,12 +405,45 @@ static void bench_vec_resize_data_ptr( benchmark::State &s ) {
 	}
 }
 
-template<typename T>
+/// As bench_vec_resize_data_ptr, but grown with vtest::resize_default_init so
+/// that, where the container allows it, each element is only written once
+template<typename Vec>
+static void bench_vec_resize_default_init( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__ );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
+	report_nominal_bytes_written<Vec>( s, not vtest::resize_default_init_skips_v<Vec> );
+	for( auto _ : s ) {
+		[=]( ) __attribute__( ( noinline ) ) {
+			Vec v;
+			benchmark::DoNotOptimize( &v );
+			vtest::resize_default_init( v, n );
+			T *ptr = v.data( );
+			for( std::size_t i = 0; i < n; ++i ) {
+				ptr[i] = T( i );
+			}
+			benchmark::ClobberMemory( );
+		}
+		( );
+	}
+}
+
+template<typename Vec, vtest::cache_mode Mode = vtest::cache_mode::warm>
 static void bench_vec_reserve_pb( benchmark::State &s ) {
+	using T = typename Vec::value_type;
 	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__, Mode );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
+	auto const rate = vtest::throughput( s, n );
 	for( auto _ : s ) {
+		vtest::prepare_iteration<Mode>( s );
 		[=]( ) __attribute__( ( noinline ) ) {
-			daw::vector<T, std::allocator<T>> v;
+			Vec v;
 			benchmark::DoNotOptimize( &v );
 			v.reserve( n );
 			for( std::size_t i = 0; i < n; ++i ) {
@@ -65,12 +455,17 @@ static void bench_vec_reserve_pb( benchmark::State &s ) {
 	}
 }
 
-template<typename T>
+template<typename Vec>
 static void bench_vec_reserve_pb_assume( benchmark::State &s ) {
+	using T = typename Vec::value_type;
 	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__ );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
 	for( auto _ : s ) {
 		[=]( ) __attribute__( ( noinline ) ) {
-			daw::vector<T, std::allocator<T>> v;
+			Vec v;
 			benchmark::DoNotOptimize( &v );
 			v.reserve( n );
 			for( std::size_t i = 0; i < n; ++i ) {
@@ -83,14 +478,20 @@ static void bench_vec_reserve_pb_assume( benchmark::State &s ) {
 	}
 }
 
-template<typename T>
+template<typename Vec>
 static void bench_vec_mmap( benchmark::State &s ) {
+	using T = typename Vec::value_type;
 	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const faults = vtest::minor_fault_counter( s );
+	auto const rss = vtest::peak_rss_counter( s );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
+	auto const rate = vtest::throughput( s, n );
 	for( auto _ : s ) {
 		[=]( ) __attribute__( ( noinline ) ) {
-			daw::vector<T, daw::MMapAlloc<T>> v;
+			Vec v;
 			benchmark::DoNotOptimize( &v );
-			v.reserve( n );
 			for( std::size_t i = 0; i < n; ++i ) {
 				v.push_back( T( i ) );
 			}
@@ -100,12 +501,18 @@ static void bench_vec_mmap( benchmark::State &s ) {
 	}
 }
 
-template<typename T>
+template<typename Vec>
 static void bench_vec_mmap_reserve_pb( benchmark::State &s ) {
+	using T = typename Vec::value_type;
 	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const faults = vtest::minor_fault_counter( s );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
+	auto const rate = vtest::throughput( s, n );
 	for( auto _ : s ) {
 		[=]( ) __attribute__( ( noinline ) ) {
-			daw::vector<T, daw::MMapAlloc<T>> v;
+			Vec v;
 			benchmark::DoNotOptimize( &v );
 			v.reserve( n );
 			for( std::size_t i = 0; i < n; ++i ) {
@@ -117,14 +524,23 @@ static void bench_vec_mmap_reserve_pb( benchmark::State &s ) {
 	}
 }
 
-template<typename T>
+template<typename Vec>
 static void bench_vec_resize_and_overwrite_assign( benchmark::State &s ) {
+	using T = typename Vec::value_type;
 	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__ );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
+	report_nominal_bytes_written<Vec>(
+	  s,
+	  not( vtest::has_resize_and_overwrite_v<Vec> or
+	       vtest::is_default_init_alloc_v<typename Vec::allocator_type> ) );
 	for( auto _ : s ) {
 		[=]( ) __attribute__( ( noinline ) ) {
-			daw::vector<T, std::allocator<T>> v;
+			Vec v;
 			benchmark::DoNotOptimize( v.data( ) );
-			v.resize_and_overwrite( n, []( T *ptr, std::size_t const N ) {
+			vtest::resize_and_overwrite( v, n, []( T *ptr, std::size_t const N ) {
 				for( std::size_t m = 0; m < N; ++m ) {
 					ptr[m] = m;
 				}
@@ -136,14 +552,25 @@ static void bench_vec_resize_and_overwrite_assign( benchmark::State &s ) {
 	}
 }
 
-template<typename T>
+template<typename Vec, vtest::cache_mode Mode = vtest::cache_mode::warm>
 static void bench_vec_resize_and_overwrite( benchmark::State &s ) {
+	using T = typename Vec::value_type;
 	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__, Mode );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
+	auto const rate = vtest::throughput( s, n );
+	report_nominal_bytes_written<Vec>(
+	  s,
+	  not( vtest::has_resize_and_overwrite_v<Vec> or
+	       vtest::is_default_init_alloc_v<typename Vec::allocator_type> ) );
 	for( auto _ : s ) {
+		vtest::prepare_iteration<Mode>( s );
 		[=]( ) __attribute__( ( noinline ) ) {
-			daw::vector<T, std::allocator<T>> v;
+			Vec v;
 			benchmark::DoNotOptimize( v.data( ) );
-			v.resize_and_overwrite( n, []( T *ptr, std::size_t const N ) {
+			vtest::resize_and_overwrite( v, n, []( T *ptr, std::size_t const N ) {
 				for( std::size_t m = 0; m < N; ++m ) {
 					std::construct_at<T>( ptr + m, m );
 				}
@@ -155,15 +582,22 @@ static void bench_vec_resize_and_overwrite( benchmark::State &s ) {
 	}
 }
 
-template<typename T>
+template<typename Vec>
 static void bench_vec_resize_and_overwrite_alloc( benchmark::State &s ) {
+	using T = typename Vec::value_type;
 	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__ );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
 	for( auto _ : s ) {
 		[=]( ) __attribute__( ( noinline ) ) {
-			daw::vector<T, std::allocator<T>> v;
+			Vec v;
 			benchmark::DoNotOptimize( v.data( ) );
-			v.resize_and_overwrite(
-			  n, []<typename Alloc>( T *ptr, std::size_t const N, Alloc alloc ) {
+			vtest::resize_and_overwrite(
+			  v,
+			  n,
+			  []<typename Alloc>( T *ptr, std::size_t const N, Alloc alloc ) {
 				  for( std::size_t m = 0; m < N; ++m ) {
 					  std::allocator_traits<Alloc>::construct( alloc, ptr + m, m );
 				  }
@@ -175,12 +609,18 @@ static void bench_vec_resize_and_overwrite_alloc( benchmark::State &s ) {
 	}
 }
 
-template<typename T>
+template<typename Vec>
 static void bench_vec_mmap_resize_and_overwrite( benchmark::State &s ) {
+	using T = typename Vec::value_type;
 	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const faults = vtest::minor_fault_counter( s );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
+	auto const rate = vtest::throughput( s, n );
 	for( auto _ : s ) {
 		[=]( ) __attribute__( ( noinline ) ) {
-			daw::vector<T, daw::MMapAlloc<T>> v;
+			Vec v;
 			benchmark::DoNotOptimize( v.data( ) );
 			v.resize_and_overwrite( n, []( T *ptr, std::size_t const N ) {
 				for( std::size_t m = 0; m < N; ++m ) {
@@ -195,9 +635,645 @@ static void bench_vec_mmap_resize_and_overwrite( benchmark::State &s ) {
 	}
 }
 
+template<typename Vec>
+static void bench_vec_arena_pb( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto arena =
+	  vtest::arena_scope<typename Vec::allocator_type>( 4 * n * sizeof( T ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__ );
+	auto const perf = vtest::perf_counters( s, n );
+	for( auto _ : s ) {
+		[=]( ) __attribute__( ( noinline ) ) {
+			Vec v;
+			benchmark::DoNotOptimize( &v );
+			for( std::size_t i = 0; i < n; ++i ) {
+				v.push_back( T( i ) );
+			}
+			benchmark::ClobberMemory( );
+		}
+		( );
+		arena.release( );
+	}
+}
+
+template<typename Vec>
+static void bench_vec_arena_resize_and_overwrite_alloc( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto arena =
+	  vtest::arena_scope<typename Vec::allocator_type>( 2 * n * sizeof( T ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__ );
+	auto const perf = vtest::perf_counters( s, n );
+	for( auto _ : s ) {
+		[=]( ) __attribute__( ( noinline ) ) {
+			Vec v;
+			benchmark::DoNotOptimize( v.data( ) );
+			vtest::resize_and_overwrite(
+			  v,
+			  n,
+			  []<typename Alloc>( T *ptr, std::size_t const N, Alloc alloc ) {
+				  for( std::size_t m = 0; m < N; ++m ) {
+					  std::allocator_traits<Alloc>::construct( alloc, ptr + m, m );
+				  }
+				  return N;
+			  } );
+			benchmark::ClobberMemory( );
+		}
+		( );
+		arena.release( );
+	}
+}
+
+/// The request-scoped pattern: build a batch of vectors that all live until
+/// the end of the request, then drop them and release the arena in one go
+template<typename Vec>
+static void bench_vec_arena_batch( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	constexpr std::size_t batch_size = 1000;
+	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto arena = vtest::arena_scope<typename Vec::allocator_type>(
+	  batch_size * 4 * n * sizeof( T ) );
+	auto batch = std::vector<Vec>( );
+	batch.reserve( batch_size );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__ );
+	auto const rate = vtest::throughput( s, batch_size * n );
+	auto const perf = vtest::perf_counters( s, batch_size * n );
+	for( auto _ : s ) {
+		[&]( ) __attribute__( ( noinline ) ) {
+			for( std::size_t b = 0; b < batch_size; ++b ) {
+				auto &v = batch.emplace_back( );
+				for( std::size_t i = 0; i < n; ++i ) {
+					v.push_back( T( i ) );
+				}
+				benchmark::DoNotOptimize( v.data( ) );
+			}
+			benchmark::ClobberMemory( );
+		}
+		( );
+		batch.clear( );
+		arena.release( );
+	}
+}
+
+template<typename Vec, vtest::simd::isa Isa>
+static void bench_vec_simd_fill( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const bytes = vtest::bandwidth( s, n * sizeof( T ) );
+	auto const perf = vtest::perf_counters( s, n );
+	for( auto _ : s ) {
+		[=]( ) __attribute__( ( noinline ) ) {
+			Vec v;
+			benchmark::DoNotOptimize( v.data( ) );
+			vtest::resize_and_overwrite( v, n, []( T *ptr, std::size_t const N ) {
+				vtest::simd::fill<Isa>( ptr, N, T( 1 ) );
+				return N;
+			} );
+			benchmark::ClobberMemory( );
+		}
+		( );
+	}
+}
+
+template<typename Vec, vtest::simd::isa Isa>
+static void bench_vec_simd_iota( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const bytes = vtest::bandwidth( s, n * sizeof( T ) );
+	auto const perf = vtest::perf_counters( s, n );
+	for( auto _ : s ) {
+		[=]( ) __attribute__( ( noinline ) ) {
+			Vec v;
+			benchmark::DoNotOptimize( v.data( ) );
+			vtest::resize_and_overwrite( v, n, []( T *ptr, std::size_t const N ) {
+				vtest::simd::iota<Isa>( ptr, N, T( 0 ) );
+				return N;
+			} );
+			benchmark::ClobberMemory( );
+		}
+		( );
+	}
+}
+
+/// Reads a source as large as the vector, so bytes_per_second counts both
+template<typename Vec, vtest::simd::isa Isa>
+static void bench_vec_simd_transform( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto source = std::vector<T>( n );
+	vtest::simd::iota( source.data( ), n, T( 0 ) );
+	auto const bytes = vtest::bandwidth( s, 2 * n * sizeof( T ) );
+	auto const perf = vtest::perf_counters( s, n );
+	for( auto _ : s ) {
+		[&]( ) __attribute__( ( noinline ) ) {
+			Vec v;
+			benchmark::DoNotOptimize( v.data( ) );
+			vtest::resize_and_overwrite(
+			  v,
+			  n,
+			  [in = source.data( )]( T *ptr, std::size_t const N ) {
+				  vtest::simd::transform<Isa>( ptr, in, N, T( 3 ), T( 1 ) );
+				  return N;
+			  } );
+			benchmark::ClobberMemory( );
+		}
+		( );
+	}
+}
+
+/// resize_and_overwrite filled by range( 1 ) workers, each writing, and so
+/// faulting in, its own pages
+template<typename Vec>
+static void bench_vec_parallel_resize_and_overwrite( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	auto pool = vtest::fill_pool( std::size_t( s.range( 1 ) ) );
+	auto const rate = vtest::throughput( s, n );
+	auto const bytes = vtest::bandwidth( s, n * sizeof( T ) );
+	for( auto _ : s ) {
+		[&]( ) __attribute__( ( noinline ) ) {
+			Vec v;
+			benchmark::DoNotOptimize( v.data( ) );
+			vtest::resize_and_overwrite( v, n, [&]( T *ptr, std::size_t const N ) {
+				vtest::parallel_fill(
+				  pool,
+				  ptr,
+				  N,
+				  []( T *first, std::size_t count, std::size_t offset ) {
+					  vtest::simd::iota( first, count, T( offset ) );
+				  } );
+				return N;
+			} );
+			benchmark::ClobberMemory( );
+		}
+		( );
+	}
+}
+
+/// The steady state of a vector hoisted out of a loop, cleared and refilled
+/// each iteration, so only the first iteration allocates
+template<typename Vec>
+static void bench_vec_reuse_pb( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__ );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
+	auto const rate = vtest::throughput( s, n );
+	Vec v;
+	for( auto _ : s ) {
+		[&]( ) __attribute__( ( noinline ) ) {
+			v.clear( );
+			benchmark::DoNotOptimize( &v );
+			for( std::size_t i = 0; i < n; ++i ) {
+				v.push_back( T( i ) );
+			}
+			benchmark::ClobberMemory( );
+		}
+		( );
+	}
+}
+
+template<typename Vec>
+static void bench_vec_reuse_resize( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__ );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
+	auto const rate = vtest::throughput( s, n );
+	Vec v;
+	for( auto _ : s ) {
+		[&]( ) __attribute__( ( noinline ) ) {
+			v.clear( );
+			v.resize( n );
+			T *ptr = v.data( );
+			benchmark::DoNotOptimize( ptr );
+			for( std::size_t i = 0; i < n; ++i ) {
+				ptr[i] = T( i );
+			}
+			benchmark::ClobberMemory( );
+		}
+		( );
+	}
+}
+
+template<typename Vec>
+static void bench_vec_reuse_resize_and_overwrite( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__ );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
+	auto const rate = vtest::throughput( s, n );
+	Vec v;
+	for( auto _ : s ) {
+		[&]( ) __attribute__( ( noinline ) ) {
+			v.clear( );
+			benchmark::DoNotOptimize( v.data( ) );
+			vtest::resize_and_overwrite( v, n, []( T *ptr, std::size_t const N ) {
+				for( std::size_t m = 0; m < N; ++m ) {
+					std::construct_at<T>( ptr + m, m );
+				}
+				return N;
+			} );
+			benchmark::ClobberMemory( );
+		}
+		( );
+	}
+}
+
+/// Grows a vector to range( 0 ) elements, keeps a 16th of them and times
+/// shrink_to_fit alone.  capacity_ratio is capacity( ) / size( ) afterwards,
+/// 1 when the spike was given back.
+template<typename Vec>
+static void bench_vec_shrink_to_fit( benchmark::State &s ) {
+	auto n = std::size_t( s.range( 0 ) );
+	auto const kept = ( std::max )( n / 16, std::size_t{ 1 } );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__ );
+	auto const perf = vtest::perf_counters( s, kept );
+	Vec v;
+	for( auto _ : s ) {
+		{
+			auto const paused = vtest::pause_timing( s );
+			v.resize( n );
+			v.resize( kept );
+		}
+		v.shrink_to_fit( );
+		benchmark::DoNotOptimize( v.data( ) );
+		benchmark::ClobberMemory( );
+	}
+	s.counters["capacity_ratio"] = static_cast<double>( v.capacity( ) ) /
+	                               static_cast<double>( v.size( ) );
+}
+
+/// range( 0 ) operations on 64 vectors, each growing one by up to 1024
+/// elements, halving and shrinking it to fit, or destroying it.  The first
+/// quarter only grows, building a spike, and the rest mixes them 5:2:1, in the
+/// same order every iteration.  Everything is destroyed by the end, so
+/// rss_after_free and the heap counters show how much of the peak the
+/// allocator kept.
+template<typename Vec>
+static void bench_vec_footprint( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const footprint = vtest::footprint_counter( s );
+	auto const rate = vtest::throughput( s, n );
+	for( auto _ : s ) {
+		[=]( ) __attribute__( ( noinline ) ) {
+			auto rng = std::mt19937_64( 42 );
+			auto slots = std::vector<std::optional<Vec>>( 64 );
+			for( std::size_t i = 0; i < n; ++i ) {
+				auto const r = rng( );
+				auto &slot = slots[r % slots.size( )];
+				auto const op = i < n / 4 ? 7U : ( r >> 8U ) % 8U;
+				switch( op ) {
+				case 0:
+					slot.reset( );
+					break;
+				case 1:
+				case 2:
+					if( slot ) {
+						slot->resize( slot->size( ) / 2 );
+						slot->shrink_to_fit( );
+					}
+					break;
+				default: {
+					auto &v = slot ? *slot : slot.emplace( );
+					auto const count = std::size_t{ 1 } << ( ( r >> 16U ) % 11U );
+					auto const size = v.size( );
+					v.resize( size + count );
+					T *ptr = v.data( );
+					for( std::size_t m = size; m < v.size( ); ++m ) {
+						ptr[m] = T( m );
+					}
+					benchmark::DoNotOptimize( ptr );
+				}
+				}
+			}
+		}
+		( );
+	}
+}
+
+/// Inserts one element at position n * Num / Den of an n element vector and
+/// pops the back, so the vector stays at n elements.  bytes_moved is what the
+/// insert shifts.
+template<typename Vec, std::size_t Num, std::size_t Den>
+static void bench_vec_insert_at( benchmark::State &s, char const *name ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	auto const pos = n * Num / Den;
+	s.SetComplexityN( s.range( 0 ) );
+	Vec v;
+	for( std::size_t i = 0; i < n; ++i ) {
+		v.push_back( T( i ) );
+	}
+	auto const compare = vtest::baseline_compare<Vec>( s, name );
+	auto const perf = vtest::perf_counters( s, 1 );
+	for( auto _ : s ) {
+		[&]( ) __attribute__( ( noinline ) ) {
+			v.insert( v.begin( ) + static_cast<std::ptrdiff_t>( pos ), T( pos ) );
+			v.pop_back( );
+			benchmark::DoNotOptimize( v.data( ) );
+			benchmark::ClobberMemory( );
+		}
+		( );
+	}
+	s.counters["bytes_moved"] = static_cast<double>( ( n - pos ) * sizeof( T ) );
+}
+
+template<typename Vec>
+static void bench_vec_insert_front( benchmark::State &s ) {
+	bench_vec_insert_at<Vec, 0, 1>( s, __func__ );
+}
+
+template<typename Vec>
+static void bench_vec_insert_middle( benchmark::State &s ) {
+	bench_vec_insert_at<Vec, 1, 2>( s, __func__ );
+}
+
+/// Erases every other element with remove_if, refilling with timing paused
+template<typename Vec>
+static void bench_vec_erase_remove_if( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__ );
+	auto const perf = vtest::perf_counters( s, n );
+	Vec v;
+	for( auto _ : s ) {
+		{
+			auto const paused = vtest::pause_timing( s );
+			v.clear( );
+			for( std::size_t i = 0; i < n; ++i ) {
+				v.push_back( T( i ) );
+			}
+		}
+		[&]( ) __attribute__( ( noinline ) ) {
+			T const *first = v.data( );
+			v.erase( std::remove_if( v.begin( ),
+			                         v.end( ),
+			                         [first]( T const &x ) {
+				                         return ( &x - first ) % 2 != 0;
+			                         } ),
+			         v.end( ) );
+			benchmark::DoNotOptimize( v.data( ) );
+			benchmark::ClobberMemory( );
+		}
+		( );
+	}
+	// Every kept element after the first removed one is moved down
+	auto const kept = ( n + 1 ) / 2;
+	s.counters["bytes_moved"] =
+	  static_cast<double>( ( kept == 0 ? 0 : kept - 1 ) * sizeof( T ) );
+}
+
+/// emplace_back( id, weight ) into a fresh vector
+template<typename Vec>
+static void bench_vec_emplace_back( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__ );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
+	auto const rate = vtest::throughput( s, n );
+	for( auto _ : s ) {
+		[=]( ) __attribute__( ( noinline ) ) {
+			Vec v;
+			benchmark::DoNotOptimize( &v );
+			for( std::size_t i = 0; i < n; ++i ) {
+				v.emplace_back( i, static_cast<double>( i ) );
+			}
+			benchmark::ClobberMemory( );
+		}
+		( );
+	}
+}
+
+/// Constructs from a range of Iterator over a std::vector of n elements
+template<typename Vec, template<typename> class Iterator>
+static void bench_vec_range_construct( benchmark::State &s, char const *name ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto source = std::vector<T>( );
+	for( std::size_t i = 0; i < n; ++i ) {
+		source.push_back( T( i ) );
+	}
+	auto const compare = vtest::baseline_compare<Vec>( s, name );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
+	auto const rate = vtest::throughput( s, n );
+	using It = Iterator<typename std::vector<T>::const_iterator>;
+	for( auto _ : s ) {
+		[&]( ) __attribute__( ( noinline ) ) {
+			auto v = Vec( It( source.cbegin( ) ), It( source.cend( ) ) );
+			benchmark::DoNotOptimize( v.data( ) );
+			benchmark::ClobberMemory( );
+		}
+		( );
+	}
+	s.counters["bytes_moved"] = static_cast<double>( n * sizeof( T ) );
+}
+
+template<typename Iterator>
+using forward_iterator = Iterator;
+
+template<typename Vec>
+static void bench_vec_range_construct_forward( benchmark::State &s ) {
+	bench_vec_range_construct<Vec, forward_iterator>( s, __func__ );
+}
+
+template<typename Vec>
+static void bench_vec_range_construct_input( benchmark::State &s ) {
+	bench_vec_range_construct<Vec, vtest::input_iterator>( s, __func__ );
+}
+
+/// Copy assigns an n element vector over one that already has the capacity
+template<typename Vec>
+static void bench_vec_copy_assign( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	Vec source;
+	for( std::size_t i = 0; i < n; ++i ) {
+		source.push_back( T( i ) );
+	}
+	Vec v;
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__ );
+	auto const perf = vtest::perf_counters( s, n );
+	auto const rate = vtest::throughput( s, n );
+	for( auto _ : s ) {
+		[&]( ) __attribute__( ( noinline ) ) {
+			v = source;
+			benchmark::DoNotOptimize( v.data( ) );
+			benchmark::ClobberMemory( );
+		}
+		( );
+	}
+	s.counters["bytes_moved"] = static_cast<double>( n * sizeof( T ) );
+}
+
+/// Move assigns an n element vector back and forth, which should only hand
+/// over the buffer
+template<typename Vec>
+static void bench_vec_move_assign( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	Vec a;
+	for( std::size_t i = 0; i < n; ++i ) {
+		a.push_back( T( i ) );
+	}
+	Vec b;
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__ );
+	for( auto _ : s ) {
+		[&]( ) __attribute__( ( noinline ) ) {
+			b = std::move( a );
+			a = std::move( b );
+			benchmark::DoNotOptimize( a.data( ) );
+			benchmark::ClobberMemory( );
+		}
+		( );
+	}
+	s.counters["bytes_moved"] = 0;
+}
+
+/// The number of chunks the byte buffer kernels append per iteration
+inline constexpr std::size_t append_chunks = 64;
+
+/// Builds a byte buffer from append_chunks chunks of range( 0 ) bytes, as a
+/// network or file reader fills one, with append( v, chunk ) adding each.
+/// bytes_per_second counts the bytes appended.
+template<typename Vec, typename Append>
+static void
+bench_bytes_append( benchmark::State &s, char const *name, Append append ) {
+	using T = typename Vec::value_type;
+	auto chunk_size = std::size_t( s.range( 0 ) );
+	auto const n = chunk_size * append_chunks;
+	s.SetComplexityN( s.range( 0 ) );
+	auto chunk = std::vector<T>( chunk_size );
+	vtest::simd::iota( chunk.data( ), chunk_size, T( 0 ) );
+	auto const compare = vtest::baseline_compare<Vec>( s, name );
+	auto const allocs = vtest::alloc_counter<T>( s, n );
+	auto const perf = vtest::perf_counters( s, n );
+	auto const bytes = vtest::bandwidth( s, n * sizeof( T ) );
+	for( auto _ : s ) {
+		[&]( ) __attribute__( ( noinline ) ) {
+			Vec v;
+			benchmark::DoNotOptimize( &v );
+			for( std::size_t i = 0; i < append_chunks; ++i ) {
+				append( v, std::span<T const>( chunk ) );
+			}
+			benchmark::ClobberMemory( );
+		}
+		( );
+	}
+}
+
+/// append_range where the container has it, otherwise insert at the end
+template<typename Vec>
+static void bench_bytes_append_span( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	bench_bytes_append<Vec>( s, __func__, []( Vec &v, std::span<T const> c ) {
+		if constexpr( requires { v.append_range( c ); } ) {
+			v.append_range( c );
+		} else {
+			v.insert( v.end( ), c.begin( ), c.end( ) );
+		}
+	} );
+}
+
+template<typename Vec>
+static void bench_bytes_insert_end( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	bench_bytes_append<Vec>( s, __func__, []( Vec &v, std::span<T const> c ) {
+		v.insert( v.end( ), c.data( ), c.data( ) + c.size( ) );
+	} );
+}
+
+/// Grows by the chunk with resize_and_overwrite and memcpys it into the new
+/// tail.  This relies on resize_and_overwrite keeping the existing elements,
+/// as std::basic_string's does.
+template<typename Vec>
+static void bench_bytes_resize_and_overwrite_memcpy( benchmark::State &s ) {
+	using T = typename Vec::value_type;
+	bench_bytes_append<Vec>( s, __func__, []( Vec &v, std::span<T const> c ) {
+		auto const old_size = v.size( );
+		vtest::resize_and_overwrite(
+		  v,
+		  old_size + c.size( ),
+		  [&]( T *ptr, std::size_t const N ) {
+			  std::memcpy( ptr + old_size, c.data( ), c.size_bytes( ) );
+			  return N;
+		  } );
+	} );
+}
+
+/// Replays a trace of vector operations, see vtest/trace.h, in Vec
+template<typename Vec>
+static void bench_trace_replay( benchmark::State &s, vtest::trace const &t ) {
+	using T = typename Vec::value_type;
+	auto const elements = t.elements( );
+	auto arena = vtest::arena_scope<typename Vec::allocator_type>( 0 );
+	auto const compare = vtest::baseline_compare<Vec>( s, __func__ );
+	auto const allocs = vtest::alloc_counter<T>( s, elements );
+	auto const perf = vtest::perf_counters( s, elements );
+	auto const rate = vtest::throughput( s, elements );
+	auto player = vtest::trace_player<Vec>( t.slots );
+	for( auto _ : s ) {
+		player.replay( t.entries );
+		benchmark::ClobberMemory( );
+		arena.release( );
+	}
+	s.counters["ops_per_second"] =
+	  benchmark::Counter( static_cast<double>( t.entries.size( ) ),
+	                      benchmark::Counter::kIsIterationInvariantRate );
+}
+
+/// The traces bench_trace_replay runs, by name: the file VTEST_TRACE names,
+/// or log-normal and Zipf traces generated with the vtest_tracegen defaults,
+/// the same as vtest_tracegen <file> [--distribution=zipf] writes.
+/// A VTEST_TRACE that cannot be read ends the program.
+static std::vector<std::pair<std::string, vtest::trace>> replay_traces( ) {
+	auto result = std::vector<std::pair<std::string, vtest::trace>>( );
+	if( char const *path = std::getenv( "VTEST_TRACE" ); path and *path ) {
+		try {
+			result.emplace_back( "file", vtest::read_trace( path ) );
+		} catch( std::exception const &ex ) {
+			// Running on without the trace would look like a clean run
+			std::cerr << "VTEST_TRACE: " << ex.what( ) << '\n';
+			std::exit( EXIT_FAILURE );
+		}
+		return result;
+	}
+	result.emplace_back( "log_normal", vtest::generate_trace( { } ) );
+	result.emplace_back(
+	  "zipf",
+	  vtest::generate_trace(
+	    { .distribution = vtest::size_distribution::zipf } ) );
+	return result;
+}
+
 template<typename T>
 static void bench_realloc_from_1( benchmark::State &s ) {
 	auto n = std::size_t( s.range( 0 ) );
+	s.SetComplexityN( s.range( 0 ) );
+	auto const perf = vtest::perf_counters( s, n );
 	for( auto _ : s ) {
 		[=]( ) __attribute__( ( noinline ) ) {
 			T *v = static_cast<T *>( malloc( sizeof( T ) * 1 ) );
@@ -231,343 +1307,380 @@ static void bench_realloc_from_1( benchmark::State &s ) {
 	}
 }
 
-template<std::size_t N>
-static void make_args( benchmark::internal::Benchmark *b ) {
-	b->Arg( N );
-}
-/*
-// unsigned char
-BENCHMARK_TEMPLATE( bench_vec_pb, unsigned char )->Apply( make_args<4> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, unsigned char )->Apply(
-make_args<4> ); BENCHMARK_TEMPLATE( bench_vec_reserve_pb, unsigned char
-)->Apply( make_args<4> ); BENCHMARK_TEMPLATE( bench_vec_reserve_pb_assume,
-unsigned char )->Apply( make_args<4> ); BENCHMARK_TEMPLATE(
-bench_vec_resize_and_overwrite, unsigned char )
-  ->Apply( make_args<4> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, unsigned char )
-  ->Apply( make_args<4> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, unsigned char )
-  ->Apply( make_args<4> );
-
-
-BENCHMARK_TEMPLATE( bench_vec_pb, unsigned char )->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, unsigned char )->Apply(
-make_args<16> ); BENCHMARK_TEMPLATE( bench_vec_reserve_pb, unsigned char
-)->Apply( make_args<16> ); BENCHMARK_TEMPLATE( bench_vec_reserve_pb_assume,
-unsigned char )->Apply( make_args<16> ); BENCHMARK_TEMPLATE(
-bench_vec_resize_and_overwrite, unsigned char )
-  ->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, unsigned char )
-  ->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, unsigned char )
-  ->Apply( make_args<16> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, unsigned char )->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, unsigned char )->Apply(
-make_args<1024> ); BENCHMARK_TEMPLATE( bench_vec_reserve_pb, unsigned char
-)->Apply( make_args<1024> ); BENCHMARK_TEMPLATE( bench_vec_reserve_pb_assume,
-unsigned char )->Apply( make_args<1024> ); BENCHMARK_TEMPLATE(
-bench_vec_resize_and_overwrite, unsigned char )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, unsigned char )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, unsigned char )
-  ->Apply( make_args<1024> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, unsigned char )->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, unsigned char )->Apply(
-make_args<4096> ); BENCHMARK_TEMPLATE( bench_vec_reserve_pb, unsigned char
-)->Apply( make_args<4096> ); BENCHMARK_TEMPLATE( bench_vec_reserve_pb_assume,
-unsigned char )->Apply( make_args<4096> ); BENCHMARK_TEMPLATE(
-bench_vec_resize_and_overwrite, unsigned char )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, unsigned char )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, unsigned char )
-  ->Apply( make_args<4096> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, unsigned char )->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, unsigned char )->Apply(
-make_args<16384> ); BENCHMARK_TEMPLATE( bench_vec_reserve_pb, unsigned char
-)->Apply( make_args<16384> ); BENCHMARK_TEMPLATE( bench_vec_reserve_pb_assume,
-unsigned char )->Apply( make_args<16384> ); BENCHMARK_TEMPLATE(
-bench_vec_resize_and_overwrite, unsigned char )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, unsigned char )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, unsigned char )
-  ->Apply( make_args<16384> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, unsigned char )->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, unsigned char )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, unsigned char )->Apply(
-make_args<5242880> ); BENCHMARK_TEMPLATE( bench_vec_reserve_pb_assume, unsigned
-char )->Apply( make_args<5242880> ); BENCHMARK_TEMPLATE(
-bench_vec_resize_and_overwrite, unsigned char )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, unsigned char )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, unsigned char )
-  ->Apply( make_args<5242880> );
-*/
-// int
-BENCHMARK_TEMPLATE( bench_vec_pb, int )->Apply( make_args<4> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, int )->Apply( make_args<4> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, int )->Apply( make_args<4> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb_assume, int )->Apply( make_args<4> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, int )
-  ->Apply( make_args<4> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, int )
-  ->Apply( make_args<4> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, int )
-  ->Apply( make_args<4> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, int )->Apply( make_args<4> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, int )->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, int )->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, int )->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb_assume, int )->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, int )
-  ->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, int )
-  ->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, int )
-  ->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, int )->Apply( make_args<16> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, int )->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, int )->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, int )->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb_assume, int )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, int )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, int )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, int )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, int )->Apply( make_args<1024> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, int )->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, int )->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, int )->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb_assume, int )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, int )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, int )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, int )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, int )->Apply( make_args<4096> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, int )->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, int )->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, int )->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb_assume, int )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, int )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, int )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, int )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, int )->Apply( make_args<16384> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, int )->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, int )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, int )->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb_assume, int )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, int )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, int )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, int )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, int )->Apply( make_args<5242880> );
-
-// long long
-BENCHMARK_TEMPLATE( bench_vec_pb, long long )->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, long long )
-  ->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, long long )->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, long long )
-  ->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, long long )
-  ->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, long long )
-  ->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, long )->Apply( make_args<16> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, long long )->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, long long )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, long long )->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, long long )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, long long )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, long long )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, long )->Apply( make_args<1024> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, long long )->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, long long )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, long long )->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, long long )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, long long )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, long long )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, long )->Apply( make_args<4096> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, long long )->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, long long )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, long long )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, long long )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, long long )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, long long )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, long )->Apply( make_args<16384> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, long long )->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, long long )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, long long )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, long long )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, long long )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, long long )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, long )->Apply( make_args<5242880> );
-
-// float
-BENCHMARK_TEMPLATE( bench_vec_pb, float )->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, float )->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, float )->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, float )
-  ->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, float )
-  ->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, float )
-  ->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, float )->Apply( make_args<16> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, float )->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, float )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, float )->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, float )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, float )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, float )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, float )->Apply( make_args<1024> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, float )->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, float )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, float )->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, float )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, float )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, float )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, float )->Apply( make_args<4096> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, float )->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, float )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, float )->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, float )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, float )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, float )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, float )->Apply( make_args<16384> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, float )->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, float )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, float )->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, float )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, float )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, float )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, float )->Apply( make_args<5242880> );
-
-// double
-BENCHMARK_TEMPLATE( bench_vec_pb, double )->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, double )->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, double )->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, double )
-  ->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, double )
-  ->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, double )
-  ->Apply( make_args<16> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, double )->Apply( make_args<16> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, double )->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, double )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, double )->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, double )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, double )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, double )
-  ->Apply( make_args<1024> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, double )->Apply( make_args<1024> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, double )->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, double )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, double )->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, double )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, double )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, double )
-  ->Apply( make_args<4096> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, double )->Apply( make_args<4096> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, double )->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, double )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, double )->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, double )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, double )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, double )
-  ->Apply( make_args<16384> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, double )->Apply( make_args<16384> );
-
-BENCHMARK_TEMPLATE( bench_vec_pb, double )->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_data_ptr, double )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_reserve_pb, double )->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite, double )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_assign, double )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_vec_resize_and_overwrite_alloc, double )
-  ->Apply( make_args<5242880> );
-BENCHMARK_TEMPLATE( bench_realloc_from_1, double )->Apply( make_args<5242880> );
+/// Registers the vector kernels with Mode set up before every iteration, as
+/// e.g. bench_vec_pb_cold_cache, over std, deprecated and daw vectors
+template<vtest::cache_mode Mode>
+static void register_cache_mode_kernels( ) {
+	using vtest::container;
+	auto const suffix = '_' + std::string( vtest::cache_mode_name( Mode ) );
+	auto const pb_name = "bench_vec_pb" + suffix;
+	auto const resize_name = "bench_vec_resize_data_ptr" + suffix;
+	auto const reserve_name = "bench_vec_reserve_pb" + suffix;
+	auto const rao_name = "bench_vec_resize_and_overwrite" + suffix;
+	vtest::register_sweep(
+	  std::tuple{ vtest::kernel{ pb_name,
+	                             []<typename Arg>( std::type_identity<Arg> ) {
+		                             return &bench_vec_pb<Arg, Mode>;
+	                             } },
+	              vtest::kernel{ resize_name,
+	                             []<typename Arg>( std::type_identity<Arg> ) {
+		                             return &bench_vec_resize_data_ptr<Arg, Mode>;
+	                             } },
+	              vtest::kernel{ reserve_name,
+	                             []<typename Arg>( std::type_identity<Arg> ) {
+		                             return &bench_vec_reserve_pb<Arg, Mode>;
+	                             } },
+	              vtest::kernel{ rao_name,
+	                             []<typename Arg>( std::type_identity<Arg> ) {
+		                             return &bench_vec_resize_and_overwrite<Arg,
+		                                                                   Mode>;
+	                             } } },
+	  vtest::types<int, double>{ },
+	  vtest::sizes{ .first = 16,
+	                .last = 1 << 23,
+	                .extra = { 5242880 },
+	                .multiplier = 8,
+	                .iterations = 64 },
+	  container<std_vec>{ "std_vec" },
+	  container<old_daw_vec>{ "old_daw_vec" },
+	  container<daw_vec>{ "daw_vec" } );
+}
+
+/// Registers the fill kernels built for Isa as e.g. bench_vec_iota_avx2, if
+/// the CPU can run them
+template<vtest::simd::isa Isa>
+static void register_simd_kernels( ) {
+	using vtest::container;
+	if( not vtest::simd::supported( Isa ) ) {
+		return;
+	}
+	auto const suffix = std::string( vtest::simd::isa_name( Isa ) );
+	auto const fill_name = "bench_vec_fill_" + suffix;
+	auto const iota_name = "bench_vec_iota_" + suffix;
+	auto const transform_name = "bench_vec_transform_" + suffix;
+	vtest::register_sweep(
+	  std::tuple{ vtest::kernel{ fill_name,
+	                             []<typename Arg>( std::type_identity<Arg> ) {
+		                             return &bench_vec_simd_fill<Arg, Isa>;
+	                             } },
+	              vtest::kernel{ iota_name,
+	                             []<typename Arg>( std::type_identity<Arg> ) {
+		                             return &bench_vec_simd_iota<Arg, Isa>;
+	                             } },
+	              vtest::kernel{ transform_name,
+	                             []<typename Arg>( std::type_identity<Arg> ) {
+		                             return &bench_vec_simd_transform<Arg, Isa>;
+	                             } } },
+	  vtest::types<unsigned char, int, float, double>{ },
+	  vtest::sizes{ .first = 1 << 12, .last = 1 << 24, .multiplier = 16 },
+	  container<daw_vec>{ "daw_vec" },
+	  container<daw_mmap_vec>{ "daw_mmap_vec" } );
+}
+
+namespace {
+	using vtest::container;
+	using vtest::sizes;
+	using vtest::types;
+
+	auto const kernels_registered = [] {
+		auto const vector_kernels =
+		  std::tuple{ VTEST_KERNEL( bench_vec_pb ),
+		              VTEST_KERNEL( bench_vec_resize_data_ptr ),
+		              VTEST_KERNEL( bench_vec_resize_default_init ),
+		              VTEST_KERNEL( bench_vec_reserve_pb ),
+		              VTEST_KERNEL( bench_vec_reserve_pb_assume ),
+		              VTEST_KERNEL( bench_vec_resize_and_overwrite ),
+		              VTEST_KERNEL( bench_vec_resize_and_overwrite_assign ),
+		              VTEST_KERNEL( bench_vec_resize_and_overwrite_alloc ) };
+		auto const scalar_types =
+		  types<unsigned char, int, long long, float, double>{ };
+		auto const scalar_sizes = sizes{ 4, 1 << 23, { 5242880 } };
+		vtest::register_sweep( vector_kernels,
+		                       scalar_types,
+		                       scalar_sizes,
+		                       container<std_vec>{ "std_vec" },
+		                       container<old_daw_vec>{ "old_daw_vec" },
+		                       container<daw_vec>{ "daw_vec" } );
+		// Sizing without zeroing, against the value-initialising runs above;
+		// nominal_bytes_written says which of them should write each element twice
+		vtest::register_sweep(
+		  std::tuple{ VTEST_KERNEL( bench_vec_resize_data_ptr ),
+		              VTEST_KERNEL( bench_vec_resize_default_init ),
+		              VTEST_KERNEL( bench_vec_resize_and_overwrite_assign ) },
+		  types<unsigned char, int, double>{ },
+		  scalar_sizes,
+		  container<default_init_std_vec>{ "default_init_std_vec" },
+		  container<default_init_daw_vec>{ "default_init_daw_vec" } );
+		// The same kernels built into cold caches and into fresh pages
+		register_cache_mode_kernels<vtest::cache_mode::cold_cache>( );
+		register_cache_mode_kernels<vtest::cache_mode::first_touch>( );
+		vtest::register_sweep( std::tuple{ VTEST_KERNEL( bench_realloc_from_1 ) },
+		                       types<int, long long, float, double>{ },
+		                       scalar_sizes );
+
+		// daw::vector on mmap backed allocators, reporting minor faults
+		vtest::register_sweep(
+		  std::tuple{ VTEST_KERNEL( bench_vec_mmap ),
+		              VTEST_KERNEL( bench_vec_mmap_reserve_pb ),
+		              VTEST_KERNEL( bench_vec_mmap_resize_and_overwrite ) },
+		  types<int, double>{ },
+		  sizes{ 1 << 14, 1 << 23, { 5242880 } },
+		  container<daw_mmap_vec>{ "daw_mmap_vec" },
+		  container<mmap_populate_vec>{ "mmap_populate_vec" },
+		  container<mmap_huge_vec>{ "mmap_huge_vec" } );
+
+		// Growing large mmap backed buffers, copying vs mremap.  bytes_relocated
+		// is what had to be copied and peak_rss what was resident at once.
+		vtest::register_sweep(
+		  std::tuple{ VTEST_KERNEL( bench_vec_mmap ) },
+		  types<int>{ },
+		  sizes{ .first = 1 << 20, .last = 1 << 28, .multiplier = 4 },
+		  container<counted_daw_mmap_vec>{ "counted_daw_mmap_vec" },
+		  container<mmap_copy_x2>{ "mmap_copy_x2" },
+		  container<mremap_x2>{ "mremap_x2" } );
+
+		auto const growth_kernels =
+		  std::tuple{ VTEST_KERNEL( bench_vec_pb ),
+		              VTEST_KERNEL( bench_vec_reserve_pb ),
+		              VTEST_KERNEL( bench_vec_resize_and_overwrite ) };
+		// Allocation counts, std::vector then daw::vector through counting_alloc
+		vtest::register_sweep( growth_kernels,
+		                       types<int, double>{ },
+		                       sizes{ 16, 1 << 23, { 5242880 } },
+		                       container<counted_std_vec>{ "counted_std_vec" },
+		                       container<counted_daw_vec>{ "counted_daw_vec" } );
+
+		// Growth policies, on the same kernel and sizes as the counted vectors
+		// so that time, peak_bytes and capacity_ratio line up
+		vtest::register_sweep(
+		  std::tuple{ VTEST_KERNEL( bench_vec_pb ) },
+		  types<int, double>{ },
+		  sizes{ 16, 1 << 23, { 5242880 } },
+		  container<realloc_x1_5>{ "realloc_x1_5" },
+		  container<realloc_phi>{ "realloc_phi" },
+		  container<realloc_x2>{ "realloc_x2" },
+		  container<realloc_capped>{ "realloc_capped" },
+		  container<realloc_x1_5_init64>{ "realloc_x1_5_init64" },
+		  container<realloc_x2_init64>{ "realloc_x2_init64" } );
+
+		// Vectors reused across iterations, on the same sizes as bench_vec_pb to
+		// show what reuse saves, and shrink_to_fit after a spike
+		vtest::register_sweep(
+		  std::tuple{ VTEST_KERNEL( bench_vec_reuse_pb ),
+		              VTEST_KERNEL( bench_vec_reuse_resize ),
+		              VTEST_KERNEL( bench_vec_reuse_resize_and_overwrite ) },
+		  types<int, double, vtest::sso_string>{ },
+		  sizes{ 16, 1 << 23, { 5242880 } },
+		  container<std_vec>{ "std_vec" },
+		  container<old_daw_vec>{ "old_daw_vec" },
+		  container<daw_vec>{ "daw_vec" } );
+		vtest::register_sweep(
+		  std::tuple{ VTEST_KERNEL( bench_vec_shrink_to_fit ) },
+		  types<int, vtest::sso_string>{ },
+		  sizes{ .first = 1 << 10, .last = 1 << 23, .multiplier = 8 },
+		  container<std_vec>{ "std_vec" },
+		  container<old_daw_vec>{ "old_daw_vec" },
+		  container<daw_vec>{ "daw_vec" } );
+
+		// Memory left behind by long grow, shrink and destroy sequences, heap
+		// against mmap backed
+		vtest::register_sweep(
+		  std::tuple{ VTEST_KERNEL( bench_vec_footprint ) },
+		  types<int>{ },
+		  sizes{ .first = 1 << 20, .last = 1 << 21, .iterations = 1 },
+		  container<std_vec>{ "std_vec" },
+		  container<daw_vec>{ "daw_vec" },
+		  container<daw_mmap_vec>{ "daw_mmap_vec" } );
+
+		// Byte buffers filled a chunk at a time, reporting bytes_per_second
+		vtest::register_sweep(
+		  std::tuple{ VTEST_KERNEL( bench_bytes_append_span ),
+		              VTEST_KERNEL( bench_bytes_insert_end ),
+		              VTEST_KERNEL( bench_bytes_resize_and_overwrite_memcpy ) },
+		  types<unsigned char>{ },
+		  sizes{ .first = 64, .last = 64 << 10, .multiplier = 4 },
+		  container<std_vec>{ "std_vec" },
+		  container<old_daw_vec>{ "old_daw_vec" },
+		  container<daw_vec>{ "daw_vec" } );
+
+		// Vectors with an inline buffer at the small end of the scalar sweep,
+		// which supplies the daw_vec timings for speedup_vs_daw and crossover_n
+		vtest::register_sweep(
+		  std::tuple{ VTEST_KERNEL( bench_vec_pb ),
+		              VTEST_KERNEL( bench_vec_resize_data_ptr ),
+		              VTEST_KERNEL( bench_vec_reserve_pb ),
+		              VTEST_KERNEL( bench_vec_resize_and_overwrite ) },
+		  types<int, double>{ },
+		  sizes{ 4, 1 << 12 },
+		  container<small_vec4>{ "small_vec4" },
+		  container<small_vec16>{ "small_vec16" } );
+
+		// Non-trivial element types
+		auto const non_trivial_types = types<vtest::sso_string,
+		                                     vtest::heap_string,
+		                                     vtest::move_only,
+		                                     vtest::owning_aggregate,
+		                                     vtest::pod64>{ };
+		auto const non_trivial_sizes = sizes{ 16, 1 << 20 };
+		vtest::register_sweep( growth_kernels,
+		                       non_trivial_types,
+		                       non_trivial_sizes,
+		                       container<std_vec>{ "std_vec" },
+		                       container<old_daw_vec>{ "old_daw_vec" },
+		                       container<daw_vec>{ "daw_vec" } );
+		vtest::register_sweep( std::tuple{ VTEST_KERNEL( bench_vec_pb ) },
+		                       non_trivial_types,
+		                       non_trivial_sizes,
+		                       container<counted_std_vec>{ "counted_std_vec" },
+		                       container<counted_daw_vec>{ "counted_daw_vec" } );
+
+		// Operations other than appending.  Kernels that copy elements skip the
+		// move only and owning types.
+		auto const std_old_daw =
+		  std::tuple{ container<std_vec>{ "std_vec" },
+		              container<old_daw_vec>{ "old_daw_vec" },
+		              container<daw_vec>{ "daw_vec" } };
+		std::apply(
+		  [&]( auto const &...cs ) {
+			  auto const op_sizes = sizes{ 16, 1 << 20 };
+			  vtest::register_sweep(
+			    std::tuple{ VTEST_KERNEL( bench_vec_insert_front ),
+			                VTEST_KERNEL( bench_vec_insert_middle ),
+			                VTEST_KERNEL( bench_vec_move_assign ) },
+			    types<int, double>{ },
+			    op_sizes,
+			    cs... );
+			  vtest::register_sweep(
+			    std::tuple{ VTEST_KERNEL( bench_vec_insert_front ),
+			                VTEST_KERNEL( bench_vec_insert_middle ),
+			                VTEST_KERNEL( bench_vec_move_assign ) },
+			    non_trivial_types,
+			    op_sizes,
+			    cs... );
+			  vtest::register_sweep(
+			    std::tuple{ VTEST_KERNEL( bench_vec_erase_remove_if ) },
+			    types<int, double>{ },
+			    sizes{ 1 << 10, 1 << 20 },
+			    cs... );
+			  vtest::register_sweep(
+			    std::tuple{ VTEST_KERNEL( bench_vec_erase_remove_if ) },
+			    non_trivial_types,
+			    sizes{ 1 << 10, 1 << 20 },
+			    cs... );
+			  vtest::register_sweep(
+			    std::tuple{ VTEST_KERNEL( bench_vec_range_construct_forward ),
+			                VTEST_KERNEL( bench_vec_range_construct_input ),
+			                VTEST_KERNEL( bench_vec_copy_assign ) },
+			    types<int,
+			          double,
+			          vtest::sso_string,
+			          vtest::heap_string,
+			          vtest::pod64>{ },
+			    op_sizes,
+			    cs... );
+			  vtest::register_sweep(
+			    std::tuple{ VTEST_KERNEL( bench_vec_emplace_back ) },
+			    types<vtest::weighted_id, vtest::owning_aggregate>{ },
+			    op_sizes,
+			    cs... );
+		  },
+		  std_old_daw );
+
+		// Request scoped arenas, released after every iteration
+		auto const arena_containers = std::tuple{
+		  container<std_vec>{ "std_vec" },
+		  container<daw_vec>{ "daw_vec" },
+		  container<pmr_mono_vec>{ "pmr_mono_vec" },
+		  container<pmr_pool_vec>{ "pmr_pool_vec" },
+		  container<arena_vec>{ "arena_vec" } };
+		std::apply(
+		  [&]( auto const &...cs ) {
+			  vtest::register_sweep(
+			    std::tuple{
+			      VTEST_KERNEL( bench_vec_arena_pb ),
+			      VTEST_KERNEL( bench_vec_arena_resize_and_overwrite_alloc ) },
+			    types<int, vtest::sso_string>{ },
+			    sizes{ 4, 1 << 20 },
+			    cs... );
+			  vtest::register_sweep(
+			    std::tuple{ VTEST_KERNEL( bench_vec_arena_batch ) },
+			    types<int, vtest::sso_string>{ },
+			    sizes{ .first = 4, .last = 4096, .multiplier = 4 },
+			    cs... );
+		  },
+		  arena_containers );
+
+		// Traces of production-like sizes, as bench_trace_replay_<trace>
+		static auto const traces = replay_traces( );
+		for( auto const &[trace_name, t] : traces ) {
+			auto const register_replay =
+			  [&]<template<typename> class C>( container<C> const &c ) {
+				  auto const name = "bench_trace_replay_" + trace_name + '<' +
+				                    std::string( c.name ) + "<int>>";
+				  benchmark::RegisterBenchmark(
+				    name.c_str( ),
+				    [&t]( benchmark::State &s ) {
+					    bench_trace_replay<C<int>>( s, t );
+				    } )
+				    ->Arg( static_cast<std::int64_t>( t.entries.size( ) ) );
+			  };
+			register_replay( container<std_vec>{ "std_vec" } );
+			register_replay( container<old_daw_vec>{ "old_daw_vec" } );
+			register_replay( container<daw_vec>{ "daw_vec" } );
+			register_replay( container<pmr_pool_vec>{ "pmr_pool_vec" } );
+		}
+
+		// Concurrent construction, to see how the allocators scale as threads
+		// are added
+		auto const max_threads = static_cast<int>(
+		  ( std::max )( std::thread::hardware_concurrency( ), 2U ) );
+		auto const threaded_sizes = sizes{ .first = 1 << 10,
+		                                   .last = 1 << 20,
+		                                   .multiplier = 32,
+		                                   .max_threads = max_threads };
+		vtest::register_sweep( growth_kernels,
+		                       types<int>{ },
+		                       threaded_sizes,
+		                       container<std_vec>{ "std_vec" },
+		                       container<daw_vec>{ "daw_vec" } );
+		vtest::register_sweep(
+		  std::tuple{ VTEST_KERNEL( bench_vec_mmap ),
+		              VTEST_KERNEL( bench_vec_mmap_reserve_pb ),
+		              VTEST_KERNEL( bench_vec_mmap_resize_and_overwrite ) },
+		  types<int>{ },
+		  threaded_sizes,
+		  container<daw_mmap_vec>{ "daw_mmap_vec" } );
+
+		// Large resize_and_overwrite filled by a pool of 1, 2, 4 ... workers
+		vtest::register_sweep(
+		  std::tuple{ VTEST_KERNEL( bench_vec_parallel_resize_and_overwrite ) },
+		  types<int, double>{ },
+		  sizes{ .first = 1 << 22,
+		         .last = 1 << 27,
+		         .extra = { 5242880 },
+		         .multiplier = 32,
+		         .max_workers = max_threads },
+		  container<daw_vec>{ "daw_vec" },
+		  container<daw_mmap_vec>{ "daw_mmap_vec" } );
+
+		// Explicitly vectorized resize_and_overwrite callbacks, against the plain
+		// loop, in bytes_per_second
+		register_simd_kernels<vtest::simd::isa::scalar>( );
+		register_simd_kernels<vtest::simd::isa::sse2>( );
+		register_simd_kernels<vtest::simd::isa::avx2>( );
+		register_simd_kernels<vtest::simd::isa::avx512>( );
+		register_simd_kernels<vtest::simd::isa::dispatch>( );
+
+#if defined( __cpp_lib_string_resize_and_overwrite )
+		// char, against std::basic_string<char>::resize_and_overwrite
+		vtest::register_sweep(
+		  std::tuple{ VTEST_KERNEL( bench_vec_resize_and_overwrite ),
+		              VTEST_KERNEL( bench_vec_resize_and_overwrite_assign ) },
+		  types<char>{ },
+		  scalar_sizes,
+		  container<std_str>{ "std_str" },
+		  container<daw_vec>{ "daw_vec" } );
+#endif
+		return true;
+	}( );
+} // namespace
@@ -0,0 +1,183 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+// Compares two vtest1 runs written with --benchmark_format=json, e.g.
+//   vtest1 --benchmark_repetitions=10 --benchmark_format=json > old.json
+//   vtest_compare old.json new.json --threshold=0.05
+// and exits with a failure status when any benchmark regressed.
+
+#include "vtest/bench_json.h"
+#include "vtest/mann_whitney.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	void usage( ) {
+		std::cerr
+		  << "usage: vtest_compare <baseline.json> <contender.json> [options]\n"
+		     "  --threshold=X   relative change in median time that counts, "
+		     "default 0.05\n"
+		     "  --alpha=X       significance level of the Mann-Whitney U test, "
+		     "default 0.05\n"
+		     "  --time=real|cpu default real\n"
+		     "  --all           list every matched benchmark, not only the\n"
+		     "                  significant changes\n";
+	}
+
+	struct options {
+		double threshold = 0.05;
+		double alpha = 0.05;
+		bool cpu_time = false;
+		bool all = false;
+	};
+
+	bool parse_option( std::string_view arg, options &opts ) {
+		if( arg == "--all" ) {
+			opts.all = true;
+			return true;
+		}
+		auto const eq = arg.find( '=' );
+		if( not arg.starts_with( "--" ) or eq == std::string_view::npos ) {
+			return false;
+		}
+		auto const key = arg.substr( 2, eq - 2 );
+		auto const value = std::string( arg.substr( eq + 1 ) );
+		if( key == "threshold" ) {
+			opts.threshold = std::stod( value );
+		} else if( key == "alpha" ) {
+			opts.alpha = std::stod( value );
+		} else if( key == "time" ) {
+			if( value != "real" and value != "cpu" ) {
+				return false;
+			}
+			opts.cpu_time = value == "cpu";
+		} else {
+			return false;
+		}
+		return true;
+	}
+
+	/// The times of each benchmark, one per repetition, by run name
+	std::map<std::string, std::vector<double>>
+	load( std::string const &path, options const &opts ) {
+		auto result = std::map<std::string, std::vector<double>>( );
+		for( auto const &run : vtest::read_bench_json( path ) ) {
+			result[run.run_name].push_back( opts.cpu_time ? run.cpu_time_ns
+			                                              : run.real_time_ns );
+		}
+		return result;
+	}
+
+	double median( std::vector<double> v ) {
+		std::sort( v.begin( ), v.end( ) );
+		auto const mid = v.size( ) / 2;
+		return v.size( ) % 2 == 1 ? v[mid] : ( v[mid - 1] + v[mid] ) / 2.0;
+	}
+
+	enum class verdict { same, improvement, regression };
+
+	struct comparison {
+		std::string name;
+		double baseline_ns;
+		double contender_ns;
+		/// contender / baseline - 1, positive when slower
+		double change;
+		double p;
+		verdict result;
+	};
+} // namespace
+
+int main( int argc, char **argv ) {
+	if( argc < 3 ) {
+		usage( );
+		return EXIT_FAILURE;
+	}
+	auto opts = options{ };
+	auto rows = std::vector<comparison>( );
+	auto unmatched = std::size_t{ 0 };
+	try {
+		for( int i = 3; i < argc; ++i ) {
+			if( not parse_option( argv[i], opts ) ) {
+				std::cerr << "unknown option " << argv[i] << '\n';
+				usage( );
+				return EXIT_FAILURE;
+			}
+		}
+		auto const baseline = load( argv[1], opts );
+		auto const contender = load( argv[2], opts );
+		for( auto const &[name, old_times] : baseline ) {
+			auto const pos = contender.find( name );
+			if( pos == contender.end( ) ) {
+				++unmatched;
+				continue;
+			}
+			auto const &new_times = pos->second;
+			auto const old_median = median( old_times );
+			auto const new_median = median( new_times );
+			auto const change =
+			  old_median > 0.0 ? new_median / old_median - 1.0 : 0.0;
+			auto const p = vtest::mann_whitney_u( old_times, new_times ).p;
+			auto result = verdict::same;
+			if( p < opts.alpha and change > opts.threshold ) {
+				result = verdict::regression;
+			} else if( p < opts.alpha and change < -opts.threshold ) {
+				result = verdict::improvement;
+			}
+			rows.push_back(
+			  comparison{ name, old_median, new_median, change, p, result } );
+		}
+		unmatched += contender.size( ) - rows.size( );
+	} catch( std::exception const &ex ) {
+		std::cerr << ex.what( ) << '\n';
+		return EXIT_FAILURE;
+	}
+
+	// Biggest regressions first
+	std::sort( rows.begin( ), rows.end( ), []( auto const &l, auto const &r ) {
+		return l.change > r.change;
+	} );
+	auto regressions = std::size_t{ 0 };
+	auto improvements = std::size_t{ 0 };
+	std::printf( "%9s %8s %14s %14s  %s\n",
+	             "change",
+	             "p",
+	             "baseline_ns",
+	             "contender_ns",
+	             "benchmark" );
+	for( auto const &row : rows ) {
+		regressions += row.result == verdict::regression;
+		improvements += row.result == verdict::improvement;
+		if( row.result == verdict::same and not opts.all ) {
+			continue;
+		}
+		std::printf( "%+8.2f%% %8.4f %14.2f %14.2f  %s%s\n",
+		             row.change * 100.0,
+		             row.p,
+		             row.baseline_ns,
+		             row.contender_ns,
+		             row.name.c_str( ),
+		             row.result == verdict::regression    ? "  REGRESSION"
+		             : row.result == verdict::improvement ? "  improvement"
+		                                                  : "" );
+	}
+	std::printf( "%zu compared, %zu regressions, %zu improvements, %zu "
+	             "unmatched\n",
+	             rows.size( ),
+	             regressions,
+	             improvements,
+	             unmatched );
+	return regressions == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
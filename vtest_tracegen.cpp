@@ -0,0 +1,100 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/
+//
+// Writes a synthetic trace for the bench_trace_replay kernels, e.g.
+//   vtest_tracegen zipf.trace --distribution=zipf --vectors=1000000
+// and run with VTEST_TRACE=zipf.trace vtest1
+
+#include "vtest/trace.h"
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace {
+	void usage( ) {
+		std::cerr
+		  << "usage: vtest_tracegen <output> [options]\n"
+		     "  --distribution=log_normal|zipf\n"
+		     "  --vectors=N           vectors created over the trace\n"
+		     "  --max-live=N          vectors live at once\n"
+		     "  --mu=X --sigma=X      log-normal parameters of ln( size )\n"
+		     "  --zipf-s=X --zipf-max=N\n"
+		     "  --max-size=N\n"
+		     "  --reserve=P --resize=P --clear=P\n"
+		     "  --seed=N\n";
+	}
+
+	bool parse_option( std::string_view arg, vtest::trace_config &config ) {
+		auto const eq = arg.find( '=' );
+		if( not arg.starts_with( "--" ) or eq == std::string_view::npos ) {
+			return false;
+		}
+		auto const key = arg.substr( 2, eq - 2 );
+		auto const value = std::string( arg.substr( eq + 1 ) );
+		if( key == "distribution" ) {
+			if( value == "log_normal" ) {
+				config.distribution = vtest::size_distribution::log_normal;
+			} else if( value == "zipf" ) {
+				config.distribution = vtest::size_distribution::zipf;
+			} else {
+				return false;
+			}
+		} else if( key == "vectors" ) {
+			config.vectors = std::stoull( value );
+		} else if( key == "max-live" ) {
+			config.max_live = static_cast<std::uint32_t>( std::stoul( value ) );
+		} else if( key == "mu" ) {
+			config.log_normal_mu = std::stod( value );
+		} else if( key == "sigma" ) {
+			config.log_normal_sigma = std::stod( value );
+		} else if( key == "zipf-s" ) {
+			config.zipf_s = std::stod( value );
+		} else if( key == "zipf-max" ) {
+			config.zipf_max = std::stoull( value );
+		} else if( key == "max-size" ) {
+			config.max_size = std::stoull( value );
+		} else if( key == "reserve" ) {
+			config.reserve_probability = std::stod( value );
+		} else if( key == "resize" ) {
+			config.resize_probability = std::stod( value );
+		} else if( key == "clear" ) {
+			config.clear_probability = std::stod( value );
+		} else if( key == "seed" ) {
+			config.seed = std::stoull( value );
+		} else {
+			return false;
+		}
+		return true;
+	}
+} // namespace
+
+int main( int argc, char **argv ) {
+	if( argc < 2 ) {
+		usage( );
+		return EXIT_FAILURE;
+	}
+	auto config = vtest::trace_config{ };
+	try {
+		for( int i = 2; i < argc; ++i ) {
+			if( not parse_option( argv[i], config ) ) {
+				std::cerr << "unknown option " << argv[i] << '\n';
+				usage( );
+				return EXIT_FAILURE;
+			}
+		}
+		auto const t = vtest::generate_trace( config );
+		vtest::write_trace( argv[1], t );
+		std::cout << argv[1] << ": " << t.entries.size( ) << " entries, "
+		          << t.elements( ) << " elements, " << t.slots << " slots\n";
+	} catch( std::exception const &ex ) {
+		std::cerr << ex.what( ) << '\n';
+		return EXIT_FAILURE;
+	}
+}